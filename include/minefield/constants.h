@@ -10,6 +10,15 @@ static int const kSpanish = 2;
 static int const kFrench = 3;
 }
 
+// Names of the language files, and of the languages in the language pack
+
+namespace codes
+{
+static char const* const kEnglish = "en";
+static char const* const kSpanish = "es";
+static char const* const kFrench = "fr";
+}
+
 } 
 
 namespace MainMenu
@@ -36,6 +45,9 @@ namespace BoardConfig
         static int const kMaxdWidth = 50;
         static int const kMinHeight = 24;
         static int const kMaxHeight = 50;
+        static long long const kMaxDenseCells = 65536; // PackedPosition keeps board indices in 16 bits
+        static int const kMaxSparseWidth = 100000;     // batch games beyond the dense limits, on a SparseBoard
+        static int const kMaxSparseHeight = 100000;
     }
 
 }
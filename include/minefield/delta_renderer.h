@@ -0,0 +1,66 @@
+#pragma once
+
+#include "terminal.h"
+#include "utils.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+    Optional board output for terminals that understand ANSI escapes. The boards live in a pane at
+    the top of the screen, one panel per player, and messages scroll in the region below it. Each
+    panel keeps the values it shows, so a player's next frame only moves the cursor to the cells
+    whose value changed and rewrites those.
+
+    The whole pane is drawn again when a panel is added or the terminal size changes. When the pane
+    does not fit the terminal, or the output is no terminal at all, frames are written in full
+    like printPerPlayer does.
+
+    Frames are rendered by the sink's jobs (see utils::board::showPerPlayer), so only the thread
+    running them touches a DeltaRenderer.
+*/
+
+class DeltaRenderer
+{
+public:
+    static constexpr unsigned int kPanelGap = 2;    // columns between panels side by side
+    static constexpr unsigned int kMinLogRows = 4;  // rows the pane leaves for the messages
+
+    void render(std::string& frame, unsigned int playerId, std::string const& name, utils::board::BoardSnapshot const& board,
+                CellBitmap const& guessedCells, CellBitmap const& ownMineCells, std::optional<TerminalSize> size);
+
+    // Hands the whole screen back to scrolling text
+
+    void close(std::string& frame);
+
+private:
+    struct Panel
+    {
+        std::string name;
+        unsigned int width = 0;
+        unsigned int height = 0;
+        std::vector<std::uint8_t> shown;  // displayed value per cell
+    };
+
+    struct Layout
+    {
+        unsigned int panelWidth = 0;
+        unsigned int panelHeight = 0;
+        unsigned int perBand = 0;
+        unsigned int paneRows = 0;
+    };
+
+    std::optional<Layout> layoutFor(TerminalSize size) const;
+    void redrawAll(std::string& frame, TerminalSize size);
+    void drawPanel(std::string& frame, std::size_t index, Panel const& panel) const;
+    void updatePanel(std::string& frame, std::size_t index, Panel& panel, std::vector<std::uint8_t>& values) const;
+    unsigned int panelTop(std::size_t index) const;
+    unsigned int panelLeft(std::size_t index) const;
+
+    std::map<unsigned int, Panel> panels;  // by player id, which is also the panel order
+    Layout layout;
+    std::optional<TerminalSize> paneSize;  // terminal size the pane is drawn for, empty while there is no pane
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "constants.h"
+#include "types.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/*
+    Board for tournament presets, where the board size and the mine count never change.
+    The dimensions are compile-time constants and the cells live in a std::array, so the compiler
+    can unroll and vectorize the scans and the rendering. The accessors match Board, so the
+    templated helpers (e.g. utils::board::printPerPlayer) work on both, and so does the free cell
+    pool, so a FixedGameContext plays GameStates drawing the same cells a Board game draws.
+*/
+
+template <unsigned int W, unsigned int H>
+struct FixedBoard
+{
+    static_assert(W > 0 && H > 0, "FixedBoard needs at least one cell");
+    static_assert(static_cast<long long>(W) * H <= BoardConfig::Limits::kMaxDenseCells, "PackedPosition stores board indices in 16 bits");
+
+    static constexpr unsigned int width = W;
+    static constexpr unsigned int height = H;
+    static constexpr std::size_t kCells = static_cast<std::size_t>(W) * H;
+
+    typedef PackedPosition Position;
+    typedef CellBitmap CellSet;
+    typedef std::vector<unsigned int> CellCounts;
+
+    std::array<PositionState, kCells> cells;
+    std::array<unsigned int, kPositionStateCount> stateCounts{};
+    std::array<std::uint16_t, kCells> owners;
+    std::array<std::uint16_t, kCells> placementRounds;
+    FreeCellPool freeCells;
+
+    static constexpr bool empty()
+    {
+        return false;
+    }
+
+    static constexpr std::size_t size()
+    {
+        return kCells;
+    }
+
+    static constexpr std::size_t index(unsigned int x, unsigned int y)
+    {
+        return static_cast<std::size_t>(y) * W + x;
+    }
+
+    constexpr unsigned int count(PositionState state) const
+    {
+        return stateCounts[static_cast<std::size_t>(state)];
+    }
+
+    constexpr PositionState state(unsigned int x, unsigned int y) const
+    {
+        return cells[index(x, y)];
+    }
+
+    void setState(unsigned int x, unsigned int y, PositionState state)
+    {
+        std::size_t cellIndex = index(x, y);
+
+        if (isFreeState(cells[cellIndex]) != isFreeState(state))
+        {
+            if (isFreeState(state))
+            {
+                freeCells.insert(cellIndex);
+            }
+            else
+            {
+                freeCells.remove(cellIndex);
+            }
+        }
+
+        --stateCounts[static_cast<std::size_t>(cells[cellIndex])];
+        ++stateCounts[static_cast<std::size_t>(state)];
+        cells[cellIndex] = state;
+    }
+
+    constexpr PackedPosition pack(MinePosition const& position) const
+    {
+        return {static_cast<std::uint16_t>(index(position.x, position.y)), position.state};
+    }
+
+    constexpr MinePosition unpack(PackedPosition const& position) const
+    {
+        return {position.index % W, position.index / W, position.state};
+    }
+
+    constexpr std::uint16_t owner(unsigned int x, unsigned int y) const
+    {
+        return owners[index(x, y)];
+    }
+
+    constexpr std::uint16_t placementRound(unsigned int x, unsigned int y) const
+    {
+        return placementRounds[index(x, y)];
+    }
+
+    void placeMine(unsigned int x, unsigned int y, unsigned int ownerId, unsigned int round)
+    {
+        setState(x, y, PositionState::WithMine);
+        owners[index(x, y)] = static_cast<std::uint16_t>(ownerId);
+        placementRounds[index(x, y)] = static_cast<std::uint16_t>(round);
+    }
+
+    constexpr PositionState operator[](std::size_t cellIndex) const
+    {
+        return cells[cellIndex];
+    }
+};
+
+namespace utils::board
+{
+
+template <unsigned int W, unsigned int H>
+void initialize(FixedBoard<W, H>& board)
+{
+    board.cells.fill(PositionState::Empty);
+    board.stateCounts.fill(0);
+    board.stateCounts[static_cast<std::size_t>(PositionState::Empty)] = static_cast<unsigned int>(board.size());
+    board.owners.fill(kNoOwner);
+    board.placementRounds.fill(0);
+    board.freeCells.reset(board.size());
+}
+
+// The call the runtime boards take, for templated callers. The size has to be the board's own
+
+template <unsigned int W, unsigned int H>
+void initialize(FixedBoard<W, H>& board, Height height, Width width)
+{
+    assert(height.getValue() == H && width.getValue() == W);
+    initialize(board);
+}
+
+template <unsigned int W, unsigned int H>
+constexpr bool hasEmptyPositions(FixedBoard<W, H> const& board)
+{
+    return std::find(board.cells.begin(), board.cells.end(), PositionState::Empty) != board.cells.end();
+}
+
+template <unsigned int W, unsigned int H>
+constexpr unsigned int countState(FixedBoard<W, H> const& board, PositionState state)
+{
+    return static_cast<unsigned int>(std::count(board.cells.begin(), board.cells.end(), state));
+}
+
+template <unsigned int W, unsigned int H>
+constexpr unsigned int countEmptyInRow(FixedBoard<W, H> const& board, unsigned int y)
+{
+    auto rowBegin = board.cells.begin() + board.index(0, y);
+    return static_cast<unsigned int>(std::count(rowBegin, rowBegin + W, PositionState::Empty));
+}
+
+} // namespace utils::board
+
+// A tournament preset game: the board size and the mine count are compile-time constants.
+// It is a BasicGameContext, so it plays the regular GameStates rounds
+
+template <unsigned int W, unsigned int H, unsigned int Mines>
+struct FixedGameContext : BasicGameContext<FixedBoard<W, H>>
+{
+    static_assert(Mines >= MineConfig::Limits::kMin && Mines <= MineConfig::Limits::kMax, "Mine count out of MineConfig::Limits");
+
+    typedef FixedBoard<W, H> BoardType;
+    static constexpr unsigned int kInitialMines = Mines;
+};
+
+namespace TournamentPresets
+{
+    typedef FixedGameContext<BoardConfig::Limits::kMinWidth, BoardConfig::Limits::kMinHeight, MineConfig::Limits::kMin> Small;
+    typedef FixedGameContext<BoardConfig::Limits::kMaxdWidth, BoardConfig::Limits::kMaxHeight, MineConfig::Limits::kMax> Large;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <coroutine>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+/*
+    Where a game's player input comes from. Prompts co_await read<T>(), which takes one value off
+    the input the way `stream >> value` does.
+
+    - Over a stream (the console) the value is read on the spot and the coroutine never suspends.
+    - Otherwise text arrives through push(). A read with nothing left to take suspends the game,
+      and the push that brings its value resumes it on the pushing thread. A value that does not
+      parse is dropped and read as T{}, where a stream would stay failed.
+*/
+
+class GameInput
+{
+public:
+    GameInput() = default;
+
+    explicit GameInput(std::istream& stream)
+    : stream(&stream)
+    {
+    }
+
+    GameInput(GameInput const&) = delete;
+    GameInput& operator=(GameInput const&) = delete;
+
+    // Appends a line of input and resumes the game if it was waiting for it
+
+    void push(std::string_view text);
+
+    // True while a game is suspended on this input
+
+    bool waiting() const
+    {
+        return static_cast<bool>(waitingGame);
+    }
+
+    template <typename T>
+    auto read()
+    {
+        struct Awaiter
+        {
+            GameInput& input;
+            T value{};
+
+            bool await_ready()
+            {
+                if (input.stream != nullptr)
+                {
+                    *input.stream >> value;
+                    return true;
+                }
+                return input.take(value);
+            }
+
+            void await_suspend(std::coroutine_handle<> game)
+            {
+                input.waitingGame = game;
+                input.resumeRead = [](GameInput& owner, void* awaiter) { return owner.take(static_cast<Awaiter*>(awaiter)->value); };
+                input.waitingRead = this;
+            }
+
+            T await_resume()
+            {
+                return std::move(value);
+            }
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    // Parses one value off the front of the pending text, false when there is none yet
+
+    template <typename T>
+    bool take(T& value)
+    {
+        std::istringstream text(pending);
+        text >> std::ws;
+
+        if (text.eof())
+        {
+            pending.clear();
+            return false;
+        }
+
+        if (!(text >> value))
+        {
+            text.clear();
+            std::string dropped;
+            text >> dropped;
+            value = T{};
+        }
+
+        std::streamoff consumed = text.eof() ? static_cast<std::streamoff>(pending.size()) : static_cast<std::streamoff>(text.tellg());
+        pending.erase(0, static_cast<std::size_t>(consumed));
+        return true;
+    }
+
+    std::istream* stream = nullptr;
+    std::string pending;
+    std::coroutine_handle<> waitingGame;
+    bool (*resumeRead)(GameInput&, void*) = nullptr;
+    void* waitingRead = nullptr;
+};
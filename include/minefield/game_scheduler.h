@@ -0,0 +1,54 @@
+#pragma once
+
+#include "game_input.h"
+#include "game_states.h"
+#include "task.h"
+#include "types.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+/*
+    Runs many interactive games on the thread that calls it. Every game is a GameStates::co::play
+    coroutine over its own GameInput: it runs until it asks for input and then stays suspended,
+    holding nothing but its state, until deliver() brings that input. Nothing here locks, so all
+    calls have to come from the same thread.
+*/
+
+class GameScheduler
+{
+public:
+    using GameId = unsigned int;
+
+    // Takes over the game's context, usually with its own output sink, and runs it up to its
+    // first prompt. A context without a current state starts at the main menu
+
+    GameId start(GameContext context);
+
+    // Feeds a line of input to a game and runs it up to its next prompt.
+    // Returns false for a game that is unknown or already over
+
+    bool deliver(GameId game, std::string_view line);
+
+    bool finished(GameId game) const;
+    GameContext const& context(GameId game) const;
+    std::size_t activeGames() const;
+
+    // Drops a game, whether it is over or still waiting for input
+
+    void remove(GameId game);
+
+private:
+    struct Game
+    {
+        GameContext context;
+        GameInput input;
+        std::optional<Task<GameOutcome>> task;
+    };
+
+    std::unordered_map<GameId, std::unique_ptr<Game>> games;
+    GameId nextId = 0;
+};
@@ -1,6 +1,20 @@
 #pragma once
 
+#include "game_input.h"
+#include "task.h"
 #include "types.h"
+#include "utils.h"
+
+#include <iostream>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/*
+    The menus and the game setup run on GameContext. The rounds, from statePuttingMines on, are
+    templates over the board (see BasicGameContext) defined at the end of this file, so every
+    board plays them the same way
+*/
 
 namespace GameStates
 {
@@ -9,9 +23,327 @@ namespace GameStates
     State stateEnteringBoardMeasures (GameContext& context);
     State stateEnteringMineCount (GameContext& context);
     State stateCreatingPlayers (GameContext& context);
-    State statePuttingMines (GameContext& context);
-    State stateProcessingMines (GameContext& context);
-    State stateGuessingMines (GameContext& context);
-    State stateProcessingGuesses (GameContext& context);
-    State stateCheckingNextTurn (GameContext& context);
-}
\ No newline at end of file
+    template <typename BoardT> BasicState<BoardT> statePuttingMines (BasicGameContext<BoardT>& context);
+    template <typename BoardT> BasicState<BoardT> stateProcessingMines (BasicGameContext<BoardT>& context);
+    template <typename BoardT> BasicState<BoardT> stateGuessingMines (BasicGameContext<BoardT>& context);
+    template <typename BoardT> BasicState<BoardT> stateProcessingGuesses (BasicGameContext<BoardT>& context);
+    template <typename BoardT> BasicState<BoardT> stateCheckingNextTurn (BasicGameContext<BoardT>& context);
+
+    /*
+        The states that read player input, as coroutines that co_await it from a GameInput. The
+        blocking states above run them over std::cin, the rest of the states are shared as they are.
+        co::play drives a whole game from context.currentState and suspends whenever the game waits
+        for input, so one thread can keep many games going (see GameScheduler)
+    */
+
+    namespace co
+    {
+        Task<NextState> stateMainMenuUpdate(GameContext& context, GameInput& input);
+        Task<NextState> stateChangeLanguage(GameContext& context, GameInput& input);
+        Task<NextState> stateEnteringBoardMeasures(GameContext& context, GameInput& input);
+        Task<NextState> stateEnteringMineCount(GameContext& context, GameInput& input);
+        Task<NextState> stateCreatingPlayers(GameContext& context, GameInput& input);
+        template <typename BoardT> Task<BasicState<BoardT>> statePuttingMines(BasicGameContext<BoardT>& context, GameInput& input);
+        template <typename BoardT> Task<BasicState<BoardT>> stateGuessingMines(BasicGameContext<BoardT>& context, GameInput& input);
+
+        Task<GameOutcome> play(GameContext& context, GameInput& input);
+    }
+}
+
+// Definitions of the round states
+
+namespace GameStates
+{
+    template <typename BoardT>
+    Task<BasicState<BoardT>> co::statePuttingMines(BasicGameContext<BoardT>& context, GameInput& input)
+    {
+        if (context.players.empty())
+        {
+            utils::printMessage(*context.output, context.language, MessageId::utilsMsg_kEmptyPlayers);
+
+            // Players are only created by the interactive game, a game on another board has none to play
+
+            if constexpr (std::is_same_v<BoardT, Board>)
+            {
+                co_return NextState{ &GameStates::stateCreatingPlayers };
+            }
+            else
+            {
+                co_return BasicState<BoardT>{ nullptr };
+            }
+        }
+
+        utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kHeader);
+
+        unsigned int minesToPlace = 0;
+
+        if (context.round.getValue() == 1)
+        {
+            minesToPlace = context.initialMines.getValue();
+
+            utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kFirstRound);
+            utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kPlayersWillPlaceMines, minesToPlace);
+        }
+        else
+        {
+            utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kRoundNumber, context.round.getValue());
+
+            // If there are more than two players, the number of mines a player can guess 
+            // is limited to the player with the fewest mines
+
+            minesToPlace = utils::player::whoHasLessAvailableMines(context.players).getValue();
+
+            if (minesToPlace == 0)
+            {
+                utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kNoAvailableMines);
+                context.outcome = GameOutcome::NoAvailableMines;
+                co_return BasicState<BoardT>{ nullptr };
+            }
+            else
+            {
+                utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kPlayersWillPlaceMines, minesToPlace);
+                context.mines.setValue(minesToPlace); 
+            }
+        }
+        
+        // Each player draws from its own stream this round, so PC moves can be picked concurrently
+
+        for (auto& player : context.players)
+        {
+            player.random.seed(context.random(), player.id);
+        }
+
+        std::vector<std::vector<MinePosition>> pcMoves = utils::game::computePCMoves(context, context.mines.getValue());
+
+        for (std::size_t i = 0; i < context.players.size(); ++i)
+        {
+            BasicPlayer<BoardT>& player = context.players[i];
+
+            utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kPlayerTurn, player.name);
+
+            if (player.type == PlayerType::PC)
+            {
+                utils::game::placeMines(context, player, pcMoves[i]);
+            }
+            else
+            {
+                co_await utils::game::enterMine(context, input, player);
+            }
+
+            utils::printMessage(*context.output, context.language, MessageId::utilsMsg_kBoardOfPlayerPrompt, player.name);
+            utils::board::showPerPlayer(context, player);
+        }
+
+        auto currentRound = context.round.getValue();
+        context.round.setValue(currentRound + 1);
+
+        co_return BasicState<BoardT>{ &GameStates::stateProcessingMines<BoardT> };
+    }
+
+    template <typename BoardT>
+    BasicState<BoardT> statePuttingMines(BasicGameContext<BoardT>& context)
+    {
+        GameInput console(std::cin);
+        return runBlocking(co::statePuttingMines(context, console));
+    }
+
+    template <typename BoardT>
+    BasicState<BoardT> stateProcessingMines(BasicGameContext<BoardT>& context)
+    {
+        utils::printMessage(*context.output, context.language, MessageId::ProcessingMines_kHeader);
+
+        std::vector<MinePosition> collisions = utils::game::findCollisions(context.board, context.players, context.placementCounts);
+
+        if (collisions.empty())
+        {
+            utils::printMessage(*context.output, context.language, MessageId::ProcessingMines_kNoCollisions);
+        }
+
+        for (auto const& mine : collisions)
+        {
+            // If two players placed a mine in the same position, it is removed
+
+            utils::printMessage(*context.output, context.language, MessageId::ProcessingMines_kColissionMsg, mine.x, mine.y);
+
+            context.board.setState(mine.x, mine.y, PositionState::Removed);
+        }
+
+        for (auto& player : context.players)
+        {
+            utils::player::saveMines(player, context.board);
+        }
+
+        return { &stateGuessingMines<BoardT> };
+    }
+
+    template <typename BoardT>
+    Task<BasicState<BoardT>> co::stateGuessingMines(BasicGameContext<BoardT>& context, GameInput& input)
+    {
+        utils::printMessage(*context.output, context.language, MessageId::GuessingMines_kHeader);
+        
+        // The number of guesses the players can make is the same
+        // to the number of mines they can place
+        
+        utils::printMessage(*context.output, context.language, MessageId::GuessingMines_kTotalMsg, context.mines.getValue());
+
+        std::vector<std::vector<MinePosition>> pcMoves = utils::game::computePCMoves(context, context.mines.getValue());
+
+        for (std::size_t p = 0; p < context.players.size(); ++p)
+        {
+            BasicPlayer<BoardT>& player = context.players[p];
+
+            utils::printMessage(*context.output, context.language, MessageId::GuessingMines_kPlayerTurn, player.name);
+
+            for (unsigned int i = 0; i < context.mines.getValue(); i++)
+            {
+                std::optional<MinePosition> minePosition;
+
+                if (player.type != PlayerType::PC)
+                {
+                    minePosition = co_await utils::board::validBoardPositionState(context.language, *context.output, input, player.random, context.board, player);
+                }
+                else if (i < pcMoves[p].size())
+                {
+                    minePosition = pcMoves[p][i];
+                }
+
+                if (!minePosition)
+                {
+                    break; // no free cell left to guess
+                }
+
+                utils::printMessage(*context.output, context.language, MessageId::GuessingMines_kSuccess, player.name, minePosition->x, minePosition->y);
+                
+                player.placedGuesses.push_back(context.board.pack(*minePosition));
+            }
+        }
+
+        co_return BasicState<BoardT>{ &GameStates::stateProcessingGuesses<BoardT> };
+    }
+
+    template <typename BoardT>
+    BasicState<BoardT> stateGuessingMines(BasicGameContext<BoardT>& context)
+    {
+        GameInput console(std::cin);
+        return runBlocking(co::stateGuessingMines(context, console));
+    }
+
+    template <typename BoardT>
+    BasicState<BoardT> stateProcessingGuesses(BasicGameContext<BoardT>& context)
+    {
+        utils::printMessage(*context.output, context.language, MessageId::ProcessingGuesses_kHeader);
+
+        // Guesses are classified in parallel against the board as the phase starts, then applied
+        // here in player order. A guess on a cell that an earlier one already changed is classified
+        // again, so the board and scores come out exactly as a one-by-one resolution would leave them
+
+        std::vector<std::vector<GuessResult>> results = utils::game::classifyGuesses(context);
+
+        typename BoardT::CellSet changedCells;
+        changedCells.reserveCells(context.board.size());
+
+        for (std::size_t p = 0; p < context.players.size(); ++p)
+        {
+            BasicPlayer<BoardT>& player = context.players[p];
+
+            utils::printMessage(*context.output, context.language, MessageId::ProcessingGuesses_kPlayerHeader, player.name);
+
+            for (std::size_t i = 0; i < player.placedGuesses.size(); ++i)
+            {
+                typename BoardT::Position const& packedGuess = player.placedGuesses[i];
+                MinePosition guess = context.board.unpack(packedGuess);
+
+                GuessResult result = changedCells.test(packedGuess.index) ? utils::game::classifyGuess(context.board, player, packedGuess) : results[p][i];
+
+                if (result == GuessResult::OwnMine) 
+                {
+                    utils::game::handleOwnMine(context.language, *context.output, player, guess, context.board);
+                } 
+                else if (result == GuessResult::OpponentMine) 
+                {
+                    utils::game::handleOpponentMine(context.language, *context.output, player, guess, context.board, context.players);
+                } 
+                else 
+                {
+                    utils::game::handleMiss(context.language, *context.output, player, guess, context.board);
+                }
+
+                changedCells.set(packedGuess.index);
+            }
+
+            utils::player::saveGuesses(player, context.board);
+            
+            utils::printMessage(*context.output, context.language, MessageId::utilsMsg_kBoardOfPlayerPrompt, player.name);
+            utils::board::showPerPlayer(context, player);
+        }
+
+        utils::printMessage(*context.output, context.language, MessageId::ProcessingGuesses_kCurrentScoresHeader);
+            
+        for (auto const& player : context.players)
+        {
+            utils::printMessage(*context.output, context.language, MessageId::ProcessingGuesses_kScoreLine, player.name, player.opponentMinesDetected.getValue(), player.ownMinesDetected.getValue());
+        }
+
+        return { &stateCheckingNextTurn<BoardT> };
+    }
+
+    template <typename BoardT>
+    BasicState<BoardT> stateCheckingNextTurn(BasicGameContext<BoardT>& context)
+    {
+        unsigned int round = context.round.getValue() - 1;
+        utils::printMessage(*context.output, context.language, MessageId::Results_kHeader, round);
+
+        BasicPlayers<BoardT> winners;
+        BasicPlayers<BoardT> eliminated;
+
+        for (auto const& player : context.players)
+        {
+            unsigned int totalOpponentMines = utils::player::countOpponentMines(player, context.players);
+
+            utils::printMessage(*context.output, context.language, MessageId::Results_kPlayerInformation, player.name, player.opponentMinesDetected.getValue(), totalOpponentMines, player.remainingMines.getValue());
+
+            if (player.opponentMinesDetected.getValue() >= totalOpponentMines && totalOpponentMines > 0)
+            {
+                winners.push_back(player);
+            }
+            
+            // Players who can't place more mines are removed
+
+            if (player.remainingMines.getValue() == 0)
+            {
+                eliminated.push_back(player);
+            } 
+        }
+
+        context.players = utils::player::getRemainigPlayers(context.players, eliminated);
+
+        /*
+            Game finishes if:
+            - A player found all oponnent mines
+            - All players were removed
+            - The board has no more available positions
+        */
+    
+        if (utils::player::areThereWinners(context.language, *context.output, winners))
+        {
+            context.outcome = GameOutcome::Winners;
+        }
+        else if (utils::game::hasOnePlayer(context.language, *context.output, context.players))
+        {
+            context.outcome = context.players.empty() ? GameOutcome::NoPlayersLeft : GameOutcome::Elimination;
+        }
+        else if (utils::board::isFull(context.language, *context.output, context.board, context.players))
+        {
+            context.outcome = GameOutcome::BoardFull;
+        }
+
+        if (context.outcome != GameOutcome::None)
+        {
+            return { nullptr };
+        }
+
+        utils::printMessage(*context.output, context.language, MessageId::Results_kProceedRound, context.round.getValue());
+        
+        return { &statePuttingMines<BoardT> };
+    }
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+#include <string_view>
 #include <unordered_map>
 
 #include <minefield/types.h>
@@ -10,6 +12,11 @@ namespace json_utils
 
 nlohmann::json loadJson(std::string const& file);
 void addToDictionary(nlohmann::json const& data, Language& dictionary, std::string const& prefix);
+std::optional<MessageId> findMessageId(std::string_view key);
+
+// Throws std::runtime_error when the file can't be read or lacks a message the game uses.
+// The build packs the language files with it, the game reads the pack (see LanguagePack)
+
 Language loadLanguage(std::string const& file);
 
 } // namespace json
\ No newline at end of file
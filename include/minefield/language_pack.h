@@ -0,0 +1,45 @@
+#pragma once
+
+#include "types.h"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+    Every language of the game in one binary file. The build writes it next to the executable
+    from the .json files in resources/minefield (`minefield --pack-languages PACK FILE...`), checking
+    each of them with json_utils::loadLanguage. The game maps it at startup, so no JSON is parsed
+    then, and the messages of every language view their texts in the mapping, which stays until
+    the last of them is gone. Switching language copies a Language, a pointer.
+
+    Layout, integers are 32 bits little-endian, so a pack written on the build machine also reads on
+    a cross-compiled target:
+    - header: "MFLP", format version, language count, message count and a hash of the message
+      keys, so a pack built for other MessageIds is refused
+    - the code of every language ("en"), zero padded to kCodeSize bytes
+    - for every language and MessageId, offset and length of its text in the string table
+    - the string table, every text one after the other
+*/
+
+class LanguagePack
+{
+public:
+    static constexpr char const* kFileName = "languages.pack";
+    static constexpr std::size_t kCodeSize = 8;
+
+    // Throws std::runtime_error when the file is missing, damaged or built for other messages
+
+    explicit LanguagePack(std::filesystem::path const& file);
+
+    // Throws std::runtime_error when the pack has no such language
+
+    Language const& language(std::string_view code) const;
+
+    static void write(std::filesystem::path const& file, std::vector<std::pair<std::string, Language>> const& languages);
+
+private:
+    std::vector<std::pair<std::string, Language>> languages;
+};
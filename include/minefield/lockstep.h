@@ -0,0 +1,89 @@
+#pragma once
+
+#include "simulation.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+    Lockstep engine for PC-only batch games: kLanes games with the same SimulationConfig advance
+    round by round together. State is laid out structure-of-arrays with the game (lane) as the
+    innermost index, so collision counting, guess classification and the counter updates are
+    branch-free loops over lanes that the compiler turns into vector code.
+
+    Every lane replays exactly what GameStates does for the same game index: same generator
+    stream, same draw order, same order of cell changes (the free-cell pool depends on it), and
+    the same accumulated mine and guess lists. Finished lanes stay masked out until the whole
+    batch is done.
+*/
+
+namespace lockstep
+{
+
+class GameBatch
+{
+public:
+    static constexpr unsigned int kLanes = 16;
+
+    explicit GameBatch(SimulationConfig const& config);
+
+    // Plays games [firstGame, firstGame + games), games <= kLanes
+
+    void play(unsigned int firstGame, unsigned int games);
+
+    GameOutcome outcome(unsigned int lane) const { return outcomes[lane]; }
+    unsigned int round(unsigned int lane) const { return rounds[lane]; }
+    unsigned int emptyCells(unsigned int lane) const { return emptyCounts[lane]; }
+
+    bool isAlive(unsigned int player, unsigned int lane) const { return alive[slot(player, lane)] != 0; }
+    unsigned int remainingMines(unsigned int player, unsigned int lane) const { return remaining[slot(player, lane)]; }
+    unsigned int opponentMinesDetected(unsigned int player, unsigned int lane) const { return opponentDetected[slot(player, lane)]; }
+    unsigned int ownMinesDetected(unsigned int player, unsigned int lane) const { return ownDetected[slot(player, lane)]; }
+
+private:
+    static std::size_t slot(unsigned int player, unsigned int lane) { return static_cast<std::size_t>(player) * kLanes + lane; }
+
+    void reset(unsigned int firstGame, unsigned int games);
+    bool anyActive() const;
+    void setCell(unsigned int lane, std::size_t cell, PositionState state);
+    std::uint16_t drawFreeCell(unsigned int lane, Pcg32& random);
+    void append(std::vector<std::uint16_t>& rows, std::vector<unsigned int>& counts, unsigned int player, unsigned int lane, std::uint16_t cell);
+    unsigned int maxRows(std::vector<unsigned int> const& counts, unsigned int player) const;
+
+    void putMines();
+    void processMines();
+    void guessMines();
+    void processGuesses();
+    void checkNextTurn();
+
+    SimulationConfig config;
+    std::size_t cellCount = 0;
+    unsigned int players = 0;
+
+    std::vector<PositionState> cells;               // [cell * kLanes + lane]
+    std::vector<std::uint8_t> ownMines;             // [(player * cellCount + cell) * kLanes + lane]
+    std::vector<std::uint16_t> placementCounts;     // [cell * kLanes + lane], zero between rounds
+
+    std::vector<std::vector<std::uint16_t>> placedMines;   // per player, [row * kLanes + lane]
+    std::vector<std::vector<std::uint16_t>> placedGuesses; // per player, [row * kLanes + lane]
+    std::vector<unsigned int> mineCounts;                  // [player * kLanes + lane]
+    std::vector<unsigned int> guessCounts;
+    std::vector<unsigned int> remaining;
+    std::vector<unsigned int> opponentDetected;
+    std::vector<unsigned int> ownDetected;
+    std::vector<std::uint8_t> alive;
+    std::vector<Pcg32> playerRandoms;                      // [player * kLanes + lane], reseeded every round
+
+    std::array<std::uint8_t, kLanes> active{};
+    std::array<unsigned int, kLanes> rounds{};
+    std::array<unsigned int, kLanes> minesPerRound{};
+    std::array<unsigned int, kLanes> emptyCounts{};
+    std::array<GameOutcome, kLanes> outcomes{};
+    std::array<FreeCellPool, kLanes> pools;
+    std::array<Pcg32, kLanes> randoms;
+};
+
+void playGames(SimulationConfig const& config, unsigned int firstGame, unsigned int games, SimulationResults& results);
+
+} // namespace lockstep
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+// A file mapped read-only into memory, one implementation per platform
+
+class MappedFile
+{
+public:
+    // Throws std::runtime_error when the file can't be opened or mapped
+
+    explicit MappedFile(std::filesystem::path const& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    std::string_view bytes() const
+    {
+        return {static_cast<char const*>(data), size};
+    }
+
+private:
+    void const* data = nullptr;
+    std::size_t size = 0;
+};
+
+// The folder of the running executable, so the files shipped next to it are found from any
+// working directory
+
+std::filesystem::path executableDirectory();
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <minefield/message_ids.h>
+
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+    A message text split once, when the language is loaded, into the literal runs between its
+    placeholders and the value each placeholder shows. Formatting then appends the runs and the
+    values straight to the caller's buffer, without parsing the text again or building a
+    temporary string.
+
+    The literal runs are ranges of the text itself, which is not copied: a template either owns
+    its text or views one kept alive by someone else, e.g. the mapped language pack.
+
+    Placeholders follow std::format: "{}", "{0}" or "{:.2f}", with "{{" and "}}" for braces.
+    A placeholder with a spec is still formatted through std::vformat_to, over only that spec.
+*/
+
+class MessageTemplate
+{
+public:
+    MessageTemplate() = default;
+
+    // Throws std::format_error when the text is not a valid format string
+
+    explicit MessageTemplate(std::string text);
+
+    // Views text, which storage keeps alive. Throws std::format_error like the owning constructor
+
+    MessageTemplate(std::string_view text, std::shared_ptr<void const> storage);
+
+    std::string_view text() const
+    {
+        return source;
+    }
+
+    // Values the text uses, one past its highest placeholder index
+
+    std::size_t argCount() const
+    {
+        return args;
+    }
+
+    template <typename... Args>
+    void formatTo(std::string& out, Args const&... values) const
+    {
+        for (Piece const& piece : pieces)
+        {
+            out.append(source.data() + piece.literalBegin, piece.literalLength);
+
+            if (piece.arg == kNoArg)
+            {
+                continue;
+            }
+
+            if (piece.arg >= sizeof...(Args))
+            {
+                throw std::format_error("Message \"" + std::string(source) + "\" needs more values than it was given");
+            }
+
+            if constexpr (sizeof...(Args) > 0)
+            {
+                appendArg(out, std::string_view(specs).substr(piece.specBegin, piece.specLength), piece.arg, values...);
+            }
+        }
+    }
+
+    template <typename... Args>
+    std::string format(Args const&... values) const
+    {
+        std::string out;
+        formatTo(out, values...);
+        return out;
+    }
+
+private:
+    static constexpr std::size_t kNoArg = static_cast<std::size_t>(-1);
+
+    // A literal run of the text, followed by the placeholder of value `arg` unless it has none
+    // (the trailing run, or a run ending in an escaped brace)
+
+    struct Piece
+    {
+        std::size_t literalBegin = 0;
+        std::size_t literalLength = 0;
+        std::size_t arg = kNoArg;
+        std::size_t specBegin = 0;
+        std::size_t specLength = 0;
+    };
+
+    template <typename First, typename... Rest>
+    static void appendArg(std::string& out, std::string_view spec, std::size_t index, First const& first, Rest const&... rest)
+    {
+        if (index > 0)
+        {
+            if constexpr (sizeof...(Rest) > 0)
+            {
+                appendArg(out, spec, index - 1, rest...);
+            }
+        }
+        else if (spec.empty())
+        {
+            std::format_to(std::back_inserter(out), "{}", first);
+        }
+        else
+        {
+            std::vformat_to(std::back_inserter(out), spec, std::make_format_args(first));
+        }
+    }
+
+    void parse();
+
+    std::shared_ptr<void const> storage;  // keeps source alive
+    std::string_view source;
+    std::string specs;  // "{:spec}" of the placeholders that have one
+    std::vector<Piece> pieces;
+    std::size_t args = 0;
+};
+
+/*
+    A MessageId checked at compile time against the values passed with it, the way std::format_string
+    checks a format string: a call passing more or fewer values than the message takes does not build.
+    Used through std::type_identity_t so the values alone deduce Args (see utils::printMessage)
+*/
+
+template <typename... Args>
+struct CheckedMessageId
+{
+    consteval CheckedMessageId(MessageId key)
+    : id(key)
+    {
+        if (kMessageArgs[static_cast<std::size_t>(key)] != sizeof...(Args))
+        {
+            throw "the message takes a different number of values";
+        }
+    }
+
+    MessageId id;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/*
+    Every game message goes through the OutputSink carried in GameContext.
+    Writers check enabled() before formatting, so a NullSink skips the work entirely
+    (see utils::printMessage)
+*/
+
+class OutputSink
+{
+public:
+    using RenderJob = std::function<void(std::string& frame)>;
+
+    virtual ~OutputSink() = default;
+
+    virtual bool enabled() const
+    {
+        return true;
+    }
+
+    virtual void write(std::string_view text) = 0;
+
+    // Text that is expensive to build, e.g. a board frame. The job fills a buffer the sink keeps
+    // from one frame to the next, which then goes out in a single write. The job must own
+    // everything it reads, since a sink may run it later on another thread
+
+    virtual void post(RenderJob render)
+    {
+        mFrame.clear();
+        render(mFrame);
+        write(mFrame);
+    }
+
+    // Called before blocking on stdin, so the prompt is shown first
+
+    virtual void flush()
+    {
+    }
+
+    // Emptied buffer for utils::printMessage to format a message into before writing it. Its
+    // capacity is kept from one message to the next, so messages do not allocate once it has grown
+
+    std::string& messageBuffer()
+    {
+        mMessage.clear();
+        return mMessage;
+    }
+
+protected:
+    std::string mFrame;
+    std::string mMessage;
+};
+
+class StdoutSink : public OutputSink
+{
+public:
+    void write(std::string_view text) override;
+    void flush() override;
+};
+
+// Keeps everything written in memory, e.g. to check messages in tests or to log a headless game
+
+class BufferSink : public OutputSink
+{
+public:
+    void write(std::string_view text) override;
+
+    std::string const& text() const;
+    void clear();
+
+private:
+    std::string mText;
+};
+
+class NullSink : public OutputSink
+{
+public:
+    bool enabled() const override;
+    void write(std::string_view text) override;
+};
+
+// Render and log stage: writes and posted jobs are queued and handed to the target sink, in the
+// order they were made, by a thread of its own. The game goes on with the next moves meanwhile.
+// Written texts are copied into strings the worker hands back, so steady writing reuses them
+
+class AsyncSink : public OutputSink
+{
+public:
+    explicit AsyncSink(std::shared_ptr<OutputSink> target);
+    ~AsyncSink() override;
+
+    AsyncSink(AsyncSink const&) = delete;
+    AsyncSink& operator=(AsyncSink const&) = delete;
+
+    bool enabled() const override;
+    void write(std::string_view text) override;
+    void post(RenderJob render) override;
+    void flush() override;
+
+private:
+    // Plain text, or a frame rendered on the worker into its reused buffer
+
+    struct Job
+    {
+        std::string text;
+        RenderJob render;
+    };
+
+    void run();
+
+    std::shared_ptr<OutputSink> mTarget;
+    std::vector<std::string> mSpareTexts;  // texts already written, reused by the next writes
+    std::mutex mMutex;
+    std::condition_variable mQueued;
+    std::condition_variable mDrained;
+    std::deque<Job> mJobs;
+    bool mBusy = false;
+    bool mStopping = false;
+    std::thread mWorker;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+/*
+    PCG32 (XSH-RR output, 64-bit LCG state). Every GameContext owns one, so games never share
+    generator state. A (seed, stream) pair fully determines the sequence; the stream picks one of
+    2^63 independent sequences, which batch runs use to give each game its own.
+*/
+
+class Pcg32
+{
+public:
+    using result_type = std::uint32_t;
+
+    Pcg32() = default;
+
+    Pcg32(std::uint64_t seedValue, std::uint64_t stream = 0)
+    {
+        seed(seedValue, stream);
+    }
+
+    void seed(std::uint64_t seedValue, std::uint64_t stream = 0)
+    {
+        state = 0;
+        increment = (stream << 1u) | 1u;
+        (*this)();
+        state += seedValue;
+        (*this)();
+    }
+
+    result_type operator()()
+    {
+        std::uint64_t old = state;
+        state = old * kMultiplier + increment;
+
+        auto xorShifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        auto rotation = static_cast<std::uint32_t>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    // Uniform in [0, range). Lemire's multiply-shift, rejecting the few low products that would bias it
+
+    result_type bounded(result_type range)
+    {
+        std::uint64_t product = static_cast<std::uint64_t>((*this)()) * range;
+        auto low = static_cast<std::uint32_t>(product);
+
+        if (low < range)
+        {
+            result_type threshold = (0u - range) % range;
+            while (low < threshold)
+            {
+                product = static_cast<std::uint64_t>((*this)()) * range;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+
+        return static_cast<result_type>(product >> 32u);
+    }
+
+    // Uniform in [0, range) for ranges past 32 bits, e.g. the cells of a SparseBoard. A range that
+    // fits in 32 bits is drawn exactly as bounded() draws it
+
+    std::uint64_t boundedWide(std::uint64_t range)
+    {
+        if (range <= max())
+        {
+            return bounded(static_cast<result_type>(range));
+        }
+
+        // Two draws make a 64-bit value; the top values that would favour the low results are drawn again
+
+        std::uint64_t const limit = UINT64_MAX - UINT64_MAX % range;
+        std::uint64_t value = 0;
+
+        do
+        {
+            std::uint64_t high = (*this)();
+            value = (high << 32u) | (*this)();
+        } while (value >= limit);
+
+        return value % range;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    static constexpr std::uint64_t kMultiplier = 6364136223846793005ULL;
+
+    std::uint64_t state = 0x853c49e6748fea9bULL;
+    std::uint64_t increment = 0xda3e39cb94b95bdbULL;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "simulation.h"
+
+#include <cstdint>
+#include <functional>
+
+/*
+    Multi-process tournaments. The coordinator forks worker processes, each one playing a contiguous
+    range (shard) of game indices, and every game writes its result into its own GameRecord in a
+    shared memory region. A worker that dies leaves the rest of its records unfinished; the
+    coordinator forks the shard again for those games only, and a fork that fails counts as one
+    of those attempts too. Games are seeded by their index
+    (see simulation::setupGame), so a retried game plays exactly as the lost one would have.
+    Only the Linux build forks, elsewhere run() falls back to the in-process tournament.
+*/
+
+struct GameRecord
+{
+    std::uint32_t rounds = 0;
+    GameOutcome outcome = GameOutcome::None;
+    std::uint8_t done = 0; // written last, a record is only read once it is set
+};
+
+struct ShardOptions
+{
+    unsigned int processes = 0; // 0 uses one per core
+    unsigned int attempts = 3;  // per shard, including the first one
+};
+
+// Failures the tests inject into run(), a regular run has none
+
+struct ShardFaults
+{
+    std::function<void(unsigned int game, unsigned int attempt)> beforeGame; // runs inside the worker
+    std::function<bool(unsigned int shard, unsigned int attempt)> failFork;  // runs in the coordinator, true fails that fork
+};
+
+namespace sharding
+{
+
+bool isSupported();
+SimulationResults run(SimulationConfig const& config, Language& language, OutputSink& output, ShardOptions const& options);
+SimulationResults run(SimulationConfig const& config, Language& language, OutputSink& output, ShardOptions const& options, ShardFaults const& faults);
+
+// Platform independent halves of run(): what a worker does and how the records are summed up
+
+void playShard(SimulationConfig const& config, Language const& language, GameRecord* records, unsigned int first, unsigned int count, unsigned int attempt, ShardFaults const& faults);
+bool isDone(GameRecord const& record);
+SimulationResults collectRecords(GameRecord const* records, unsigned int games);
+
+} // namespace sharding
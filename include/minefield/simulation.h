@@ -0,0 +1,71 @@
+#pragma once
+
+#include "types.h"
+
+#include <array>
+#include <functional>
+#include <optional>
+
+/*
+    Headless batch mode: plays complete PC-only games through the regular GameStates functions,
+    starting at statePuttingMines with everything stdin would have asked for already filled in.
+    Game messages go to a NullSink, only the final report is printed.
+
+    Fields with more cells than a dense Board holds (kMaxDenseCells), up to kMaxSparse*, are played
+    through the same states on a SparseBoard, and need a round limit to finish in time. A tournament
+    preset (--preset) is played through them on its FixedBoard.
+*/
+
+enum class BoardPreset
+{
+    None,
+    Small,  // TournamentPresets::Small
+    Large   // TournamentPresets::Large
+};
+
+struct SimulationConfig
+{
+    Width width{BoardConfig::Limits::kMinWidth};
+    Height height{BoardConfig::Limits::kMinHeight};
+    MinesCount mines{MineConfig::Limits::kMin};
+    unsigned int players = 2;
+    unsigned int seed = 1;
+    unsigned int games = 1000;
+    unsigned int threads = 1;   // more than one, or 0 for one per core, runs a tournament
+    unsigned int processes = 0; // more than zero shards the games across worker processes
+    unsigned int maxRounds = 0; // a game still running after this many rounds stops unfinished, 0 for no limit
+    bool lockstep = false;      // plays through lockstep::GameBatch instead of GameStates
+    BoardPreset preset = BoardPreset::None; // sets the board size and the mines, and plays on the preset's FixedBoard
+};
+
+struct SimulationResults
+{
+    unsigned int games = 0;
+    unsigned long long rounds = 0;
+    std::array<unsigned int, kGameOutcomeCount> outcomes{};
+    double seconds = 0.0;
+};
+
+// Lets a caller of simulation::playGames leave games out and take each result as soon as its game ends
+
+struct GameHooks
+{
+    std::function<bool(unsigned int game)> skip; // true leaves the game out, e.g. one played already
+    std::function<void(unsigned int game, GameOutcome outcome, unsigned int round)> played; // round the game stopped in
+};
+
+namespace simulation
+{
+
+bool isBatchRequest(int argc, char* argv[]);
+std::optional<SimulationConfig> parseArguments(int argc, char* argv[]);
+template <typename BoardT> void setupGame(BasicGameContext<BoardT>& context, SimulationConfig const& config, unsigned int game);
+bool needsSparseBoard(SimulationConfig const& config);
+template <typename BoardT> GameOutcome playGame(BasicGameContext<BoardT>& context, unsigned int maxRounds = 0);
+void playGames(GameContext& context, SimulationConfig const& config, unsigned int firstGame, unsigned int games, GameHooks const& hooks);
+void playGames(GameContext& context, SimulationConfig const& config, unsigned int firstGame, unsigned int games, SimulationResults& results);
+void mergeResults(SimulationResults& into, SimulationResults const& from);
+SimulationResults runBatch(SimulationConfig const& config, Language const& language);
+void printReport(Language& language, OutputSink& output, SimulationResults const& results);
+
+} // namespace simulation
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "types.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// PackedPosition with room for the index of any SparseBoard cell
+
+struct SparsePosition
+{
+    std::uint64_t index = 0;
+    PositionState state = PositionState::Empty;
+
+    bool operator==(SparsePosition const& other) const
+    {
+        return index == other.index;
+    }
+};
+
+/*
+    Board for very large fields (e.g. 100000x100000), where only cells with mines or guesses matter.
+    Cells are grouped in kTileSide x kTileSide tiles that are allocated the first time one of their
+    cells is written, so memory grows with the touched cells instead of width * height.
+    Reading a cell of a missing tile gives the state of a fresh cell: Empty and without owner.
+
+    It offers the same accessors as Board (state, setState, count, placeMine, owner, freeCells, ...)
+    and is initialized with utils::board::initialize(), so GameStates plays on it through a
+    BasicGameContext<SparseBoard>. Batch games pick it for fields past kMaxDenseCells.
+*/
+
+struct SparseBoard
+{
+    static unsigned int const kTileSide = 8;
+    static unsigned int const kTileCells = kTileSide * kTileSide;
+
+    typedef SparsePosition Position;
+
+    struct Tile
+    {
+        Tile();
+
+        std::array<PositionState, kTileCells> states;
+        std::array<std::uint16_t, kTileCells> owners;
+        std::array<std::uint16_t, kTileCells> placementRounds;
+    };
+
+    // Cells a player placed or guessed on, what a CellBitmap is for the dense boards
+
+    struct CellSet
+    {
+        std::unordered_set<std::uint64_t> cells;
+
+        void reserveCells(std::uint64_t) {}
+
+        bool test(std::uint64_t cellIndex) const
+        {
+            return cells.count(cellIndex) != 0;
+        }
+
+        void set(std::uint64_t cellIndex)
+        {
+            cells.insert(cellIndex);
+        }
+    };
+
+    // Per-cell counters, used like the std::vector of the dense boards. Nothing is sized up front,
+    // a counter is made the first time its cell is counted
+
+    struct CellCounts
+    {
+        std::unordered_map<std::uint64_t, unsigned int> counts;
+
+        void resize(std::uint64_t, unsigned int) {}
+
+        unsigned int& operator[](std::uint64_t cellIndex)
+        {
+            return counts[cellIndex];
+        }
+    };
+
+    /*
+        The free cells (see isFreeState), kept as the sorted list of the cells that are not free.
+        The free cell at a slot is found by a binary search over that list, so a pick is a single
+        draw as with Board::freeCells, and memory follows the blocked cells only. Slots go in
+        cell index order
+    */
+
+    struct FreeCells
+    {
+        std::uint64_t cellCount = 0;
+        std::vector<std::uint64_t> blocked;
+
+        void reset(std::uint64_t count);
+        bool empty() const;
+        std::uint64_t size() const;
+        std::uint64_t at(std::uint64_t slot) const;
+        void insert(std::uint64_t cellIndex);
+        void remove(std::uint64_t cellIndex);
+    };
+
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::unordered_map<std::uint64_t, Tile> tiles;
+    std::array<std::uint64_t, kPositionStateCount> stateCounts{};
+    FreeCells freeCells;
+
+    bool empty() const;
+    std::uint64_t size() const;
+    std::uint64_t index(unsigned int x, unsigned int y) const;
+    std::uint64_t count(PositionState state) const;
+    PositionState state(unsigned int x, unsigned int y) const;
+    void setState(unsigned int x, unsigned int y, PositionState state);
+    Position pack(MinePosition const& position) const;
+    MinePosition unpack(Position const& position) const;
+    std::uint16_t owner(unsigned int x, unsigned int y) const;
+    std::uint16_t placementRound(unsigned int x, unsigned int y) const;
+    void placeMine(unsigned int x, unsigned int y, unsigned int ownerId, unsigned int round);
+    PositionState operator[](std::uint64_t cellIndex) const;
+
+private:
+    static std::uint64_t tileKey(unsigned int x, unsigned int y);
+    static unsigned int cellInTile(unsigned int x, unsigned int y);
+    Tile const* findTile(unsigned int x, unsigned int y) const;
+    Tile& touchTile(unsigned int x, unsigned int y);
+};
+
+namespace utils::board
+{
+
+void initialize(SparseBoard& board, Height height, Width width);
+
+} // namespace utils::board
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+/*
+    Lazily started coroutine returning a T, or nothing for Task<void>. Awaiting a Task runs it and
+    transfers control straight back to the awaiting coroutine when it finishes, so nested states and
+    prompts suspend as one chain: whoever resumes the innermost await (see GameInput) drives the
+    whole game forward.
+
+    runBlocking drives a Task whose awaits never suspend, which is how the synchronous
+    GameStates functions reuse the coroutine ones over std::cin.
+*/
+
+template <typename T>
+struct TaskResult
+{
+    std::optional<T> value;
+
+    template <typename U>
+    void return_value(U&& result)
+    {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take()
+    {
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskResult<void>
+{
+    void return_void()
+    {
+    }
+
+    void take()
+    {
+    }
+};
+
+template <typename T>
+class Task
+{
+public:
+    struct promise_type : TaskResult<T>
+    {
+        std::exception_ptr exception;
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        Task get_return_object()
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept { return handle.promise().continuation; }
+                void await_resume() noexcept {}
+            };
+            return FinalAwaiter{};
+        }
+
+        void unhandled_exception()
+        {
+            exception = std::current_exception();
+        }
+    };
+
+    Task(Task&& other) noexcept
+    : handle(std::exchange(other.handle, nullptr))
+    {
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    ~Task()
+    {
+        destroy();
+    }
+
+    // Starts a top-level task, it runs until its first suspension
+
+    void start()
+    {
+        handle.resume();
+    }
+
+    bool done() const
+    {
+        return handle.done();
+    }
+
+    T result()
+    {
+        return take(handle);
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+            {
+                handle.promise().continuation = caller;
+                return handle;
+            }
+
+            T await_resume()
+            {
+                return take(handle);
+            }
+        };
+        return Awaiter{handle};
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle)
+    : handle(handle)
+    {
+    }
+
+    static T take(std::coroutine_handle<promise_type> handle)
+    {
+        promise_type& promise = handle.promise();
+
+        if (promise.exception)
+        {
+            std::rethrow_exception(promise.exception);
+        }
+
+        return promise.take();
+    }
+
+    void destroy()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <typename T>
+T runBlocking(Task<T> task)
+{
+    task.start();
+    assert(task.done() && "runBlocking needs an input that never suspends");
+    return task.result();
+}
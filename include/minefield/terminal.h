@@ -0,0 +1,26 @@
+#pragma once
+
+#include <optional>
+
+// What the game needs to know about the terminal it writes to, one implementation per platform
+
+struct TerminalSize
+{
+    unsigned int rows = 0;
+    unsigned int columns = 0;
+
+    bool operator==(TerminalSize const& other) const = default;
+};
+
+namespace terminal
+{
+
+// Empty when stdout is not a terminal, e.g. redirected to a file
+
+std::optional<TerminalSize> size();
+
+// Makes sure cursor movement escapes are understood, false when they can't be used
+
+bool enableEscapes();
+
+} // namespace terminal
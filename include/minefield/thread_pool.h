@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Work-stealing thread pool. Every worker owns a deque: it takes its own tasks from the back and,
+    once it runs dry, steals from the front of the other workers' deques. Tasks receive the index of
+    the worker running them, so callers can keep per-worker state without any locking of their own.
+*/
+
+class ThreadPool
+{
+public:
+    using Task = std::function<void(unsigned int worker)>;
+
+    explicit ThreadPool(unsigned int threads = 0); // 0 uses std::thread::hardware_concurrency()
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    unsigned int size() const { return static_cast<unsigned int>(workers.size()); }
+
+    void submit(Task task);
+    void wait(); // blocks until every submitted task has finished
+
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popOwn(unsigned int worker, Task& task);
+    bool steal(unsigned int worker, Task& task);
+    void workerLoop(unsigned int worker);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    std::size_t queued = 0;  // tasks sitting in some deque
+    std::size_t pending = 0; // tasks submitted but not finished
+    std::size_t nextQueue = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "simulation.h"
+
+/*
+    Parallel version of simulation::runBatch. Games are cut into fixed-size tasks and scheduled on a
+    ThreadPool; every worker plays on its own GameContext and keeps its own SimulationResults, which
+    are merged once all tasks are done. Games are seeded by their index (see simulation::setupGame),
+    so a tournament gives exactly the totals of simulation::runBatch, whatever the number of threads.
+*/
+
+namespace tournament
+{
+
+static unsigned int const kGamesPerTask = 256;
+
+SimulationResults run(SimulationConfig const& config, Language const& language);
+
+} // namespace tournament
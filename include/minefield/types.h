@@ -1,8 +1,25 @@
 #pragma once
 
+#include "constants.h"
+#include "message_template.h"
+#include "output.h"
+#include "random.h"
+#include "thread_pool.h"
+
+#include <minefield/message_ids.h>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 
 template <typename T, typename TagT>
 class StrongType
@@ -39,7 +56,7 @@ typedef StrongType<unsigned int, struct MinesCountTag> MinesCount;
 typedef StrongType<unsigned int, struct GuessesCountTag> GuessesCount;
 typedef StrongType<unsigned int, struct DetectedMinesTag> DetectedMines;
 
-enum class PositionState
+enum class PositionState : std::uint8_t
 {
     Empty,         // -> 0
     WithMine,      // -> 1 
@@ -48,6 +65,37 @@ enum class PositionState
     GuessedMine    // -> 4, a player correctly guessed a mine
 };
 
+static std::size_t const kPositionStateCount = 5;
+static std::uint16_t const kNoOwner = UINT16_MAX;
+
+// Cells a player can still pick for a mine or a guess
+
+constexpr bool isFreeState(PositionState state)
+{
+    return state == PositionState::Empty || state == PositionState::WithMine;
+}
+
+enum class GameOutcome
+{
+    None,              // the game is still running
+    Winners,           // someone found all opponent mines
+    Elimination,       // only one player is left
+    NoPlayersLeft,     // every player was eliminated in the same round
+    BoardFull,         // no empty position left
+    NoAvailableMines   // a round started with nobody able to place mines
+};
+
+static std::size_t const kGameOutcomeCount = 6;
+
+// What a guess hits, decided in stateProcessingGuesses
+
+enum class GuessResult : std::uint8_t
+{
+    OwnMine,
+    OpponentMine,
+    Miss
+};
+
 enum class PlayerType
 {
     None,
@@ -72,57 +120,497 @@ struct MinePosition
     }
 };
 
-struct Player;
-struct State;
-struct GameContext;
+// Compact form of a MinePosition used in histories: the linear board index
+// (BoardConfig::Limits keep boards below 2^16 cells) plus the state byte.
+// Board::pack() and Board::unpack() convert between both forms
+
+struct PackedPosition
+{
+    std::uint16_t index = 0;
+    PositionState state = PositionState::Empty;
+
+    bool operator==(PackedPosition const& other) const
+    {
+        return index == other.index;
+    }
+};
+
+// Bitboard view of the board: one bit per cell for every PositionState,
+// so board-wide queries become popcounts over 64-cell words.
+// It is optional and stays empty until utils::board::enablePlanes() is called
+
+struct BoardPlanes
+{
+    static std::size_t const kBitsPerWord = 64;
+
+    std::array<std::vector<std::uint64_t>, kPositionStateCount> bits;
+
+    bool enabled() const
+    {
+        return !bits[0].empty();
+    }
+
+    std::vector<std::uint64_t> const& plane(PositionState state) const
+    {
+        return bits[static_cast<std::size_t>(state)];
+    }
+
+    void set(std::size_t cellIndex, PositionState state)
+    {
+        bits[static_cast<std::size_t>(state)][cellIndex / kBitsPerWord] |= std::uint64_t{1} << (cellIndex % kBitsPerWord);
+    }
+
+    void clear(std::size_t cellIndex, PositionState state)
+    {
+        bits[static_cast<std::size_t>(state)][cellIndex / kBitsPerWord] &= ~(std::uint64_t{1} << (cellIndex % kBitsPerWord));
+    }
+};
+
+// 2D Fenwick tree per PositionState, answering "how many cells in this rectangle are in
+// state S" in O(log W * log H) and updated in the same time when a cell changes.
+// Like BoardPlanes it is optional, utils::board::enableRangeIndex() fills it in
+
+struct BoardRangeIndex
+{
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::array<std::vector<unsigned int>, kPositionStateCount> trees;
+
+    bool enabled() const
+    {
+        return !trees[0].empty();
+    }
+
+    void add(unsigned int x, unsigned int y, PositionState state, int delta)
+    {
+        std::vector<unsigned int>& tree = trees[static_cast<std::size_t>(state)];
+
+        for (unsigned int i = x + 1; i <= width; i += i & (~i + 1))
+        {
+            for (unsigned int j = y + 1; j <= height; j += j & (~j + 1))
+            {
+                tree[static_cast<std::size_t>(j - 1) * width + (i - 1)] += static_cast<unsigned int>(delta);
+            }
+        }
+    }
+
+    // Cells in state within [0, xEnd) x [0, yEnd)
+
+    unsigned int prefix(PositionState state, unsigned int xEnd, unsigned int yEnd) const
+    {
+        std::vector<unsigned int> const& tree = trees[static_cast<std::size_t>(state)];
+        unsigned int sum = 0;
+
+        for (unsigned int i = xEnd; i > 0; i -= i & (~i + 1))
+        {
+            for (unsigned int j = yEnd; j > 0; j -= j & (~j + 1))
+            {
+                sum += tree[static_cast<std::size_t>(j - 1) * width + (i - 1)];
+            }
+        }
+
+        return sum;
+    }
+};
+
+// One bit per board cell, indexed like Board::cells
+
+struct CellBitmap
+{
+    std::vector<std::uint64_t> words;
+
+    void reserveCells(std::size_t cellCount)
+    {
+        if (words.empty())
+        {
+            words.assign((cellCount + BoardPlanes::kBitsPerWord - 1) / BoardPlanes::kBitsPerWord, 0);
+        }
+    }
+
+    bool test(std::size_t cellIndex) const
+    {
+        std::size_t word = cellIndex / BoardPlanes::kBitsPerWord;
+        return word < words.size() && ((words[word] >> (cellIndex % BoardPlanes::kBitsPerWord)) & 1) != 0;
+    }
+
+    void set(std::size_t cellIndex)
+    {
+        words[cellIndex / BoardPlanes::kBitsPerWord] |= std::uint64_t{1} << (cellIndex % BoardPlanes::kBitsPerWord);
+    }
+};
+
+// Indexable set of the free cells (see isFreeState), so a PC pick is a single uniform draw.
+// cells lists them in no particular order, slots[cellIndex] is where a cell sits in that list.
+// Removal moves the last listed cell into the hole, both operations are O(1)
+
+struct FreeCellPool
+{
+    static std::uint32_t const kNotFree = UINT32_MAX;
+
+    std::vector<std::uint16_t> cells;
+    std::vector<std::uint32_t> slots;
+
+    void reset(std::size_t cellCount)
+    {
+        cells.resize(cellCount);
+        slots.resize(cellCount);
+
+        for (std::size_t i = 0; i < cellCount; ++i)
+        {
+            cells[i] = static_cast<std::uint16_t>(i);
+            slots[i] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    bool empty() const
+    {
+        return cells.empty();
+    }
+
+    std::size_t size() const
+    {
+        return cells.size();
+    }
+
+    // The cell listed at slot, slot < size()
+
+    std::size_t at(std::size_t slot) const
+    {
+        return cells[slot];
+    }
+
+    bool contains(std::size_t cellIndex) const
+    {
+        return slots[cellIndex] != kNotFree;
+    }
+
+    void insert(std::size_t cellIndex)
+    {
+        slots[cellIndex] = static_cast<std::uint32_t>(cells.size());
+        cells.push_back(static_cast<std::uint16_t>(cellIndex));
+    }
+
+    void remove(std::size_t cellIndex)
+    {
+        std::uint32_t slot = slots[cellIndex];
+        std::uint16_t last = cells.back();
+
+        cells[slot] = last;
+        slots[last] = slot;
+        cells.pop_back();
+        slots[cellIndex] = kNotFree;
+    }
+};
+
+// Row-major board: the cell at (x, y) lives at cells[y * width + x],
+// each cell is the packed byte of its PositionState.
+// stateCounts holds how many cells are in each state, so occupancy checks don't need a scan.
+// owners and placementRounds record who committed the mine in a cell and when,
+// freeCells tracks the cells that can still be picked.
+// Position, CellSet and CellCounts are the types a game keeps per board cell (see BasicGameContext)
 
-typedef std::vector<std::vector<MinePosition>> Board;
-typedef std::vector<Player> Players;
+struct Board
+{
+    typedef PackedPosition Position;
+    typedef CellBitmap CellSet;
+    typedef std::vector<unsigned int> CellCounts;
+
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<PositionState> cells;
+    std::array<unsigned int, kPositionStateCount> stateCounts{};
+    std::vector<std::uint16_t> owners;
+    std::vector<std::uint16_t> placementRounds;
+    FreeCellPool freeCells;
+    BoardPlanes planes;
+    BoardRangeIndex rangeIndex;
+
+    bool empty() const
+    {
+        return cells.empty();
+    }
+
+    std::size_t size() const
+    {
+        return cells.size();
+    }
+
+    std::size_t index(unsigned int x, unsigned int y) const
+    {
+        return static_cast<std::size_t>(y) * width + x;
+    }
+
+    unsigned int count(PositionState state) const
+    {
+        return stateCounts[static_cast<std::size_t>(state)];
+    }
+
+    PositionState state(unsigned int x, unsigned int y) const
+    {
+        return cells[index(x, y)];
+    }
+
+    void setState(unsigned int x, unsigned int y, PositionState state)
+    {
+        std::size_t cellIndex = index(x, y);
+
+        if (planes.enabled())
+        {
+            planes.clear(cellIndex, cells[cellIndex]);
+            planes.set(cellIndex, state);
+        }
+
+        if (rangeIndex.enabled())
+        {
+            rangeIndex.add(x, y, cells[cellIndex], -1);
+            rangeIndex.add(x, y, state, 1);
+        }
+
+        if (isFreeState(cells[cellIndex]) != isFreeState(state))
+        {
+            if (isFreeState(state))
+            {
+                freeCells.insert(cellIndex);
+            }
+            else
+            {
+                freeCells.remove(cellIndex);
+            }
+        }
+
+        --stateCounts[static_cast<std::size_t>(cells[cellIndex])];
+        ++stateCounts[static_cast<std::size_t>(state)];
+        cells[cellIndex] = state;
+    }
+
+    PackedPosition pack(MinePosition const& position) const
+    {
+        return {static_cast<std::uint16_t>(index(position.x, position.y)), position.state};
+    }
+
+    MinePosition unpack(PackedPosition const& position) const
+    {
+        return {position.index % width, position.index / width, position.state};
+    }
+
+    std::uint16_t owner(unsigned int x, unsigned int y) const
+    {
+        return owners[index(x, y)];
+    }
+
+    std::uint16_t placementRound(unsigned int x, unsigned int y) const
+    {
+        return placementRounds[index(x, y)];
+    }
+
+    void placeMine(unsigned int x, unsigned int y, unsigned int ownerId, unsigned int round)
+    {
+        setState(x, y, PositionState::WithMine);
+        owners[index(x, y)] = static_cast<std::uint16_t>(ownerId);
+        placementRounds[index(x, y)] = static_cast<std::uint16_t>(round);
+    }
+
+    PositionState operator[](std::size_t cellIndex) const
+    {
+        return cells[cellIndex];
+    }
+};
+
+template <typename BoardT> struct BasicPlayer;
+template <typename BoardT> struct BasicState;
+template <typename BoardT> struct BasicGameContext;
+class DeltaRenderer;
+class LanguagePack;
+
+template <typename BoardT>
+using BasicPlayers = std::vector<BasicPlayer<BoardT>>;
+
+// The interactive game and everything written for it play on the dense Board
+
+typedef BasicPlayer<Board> Player;
+typedef BasicPlayers<Board> Players;
+typedef BasicState<Board> State;
+typedef BasicGameContext<Board> GameContext;
 typedef State NextState;
 typedef NextState (*StateUpdateFn)(GameContext&);
 typedef void (*EnterMineFn)(GameContext&, Player&);
-typedef std::unordered_map<std::string, std::string> Language;
+
+// Every text of one language, indexed by MessageId. The IDs are generated from
+// resources/minefield/en.json at build time, so a lookup is an array index.
+// Copies share the texts, so handing a language over or switching to another one copies a
+// pointer. The texts are only copied when a shared language is changed
+
+class Language
+{
+public:
+    Language() = default;
+
+    // Only the given messages, the rest stay empty. Meant for tests
+
+    Language(std::initializer_list<std::pair<MessageId, std::string>> entries)
+    {
+        for (auto const& [id, text] : entries)
+        {
+            set(id, text);
+        }
+    }
+
+    std::string_view operator[](MessageId id) const
+    {
+        return table->messages[static_cast<std::size_t>(id)].text();
+    }
+
+    // The message parsed when it was set, to be formatted without parsing it again
+
+    MessageTemplate const& message(MessageId id) const
+    {
+        return table->messages[static_cast<std::size_t>(id)];
+    }
+
+    // Throws std::format_error when the text is not a valid format string
+
+    void set(MessageId id, std::string text)
+    {
+        store(id, MessageTemplate(std::move(text)));
+    }
+
+    // Same, leaving the text where it is: storage keeps it alive, e.g. the mapped language pack
+
+    void set(MessageId id, std::string_view text, std::shared_ptr<void const> storage)
+    {
+        store(id, MessageTemplate(text, std::move(storage)));
+    }
+
+    bool has(MessageId id) const
+    {
+        return table->loaded[static_cast<std::size_t>(id)];
+    }
+
+    // Refuses a language missing a text, or with a text using other values than the game formats
+    // it with, instead of showing a wrong message later in the game. Throws std::runtime_error
+    // naming the message and where the language came from
+
+    void checkComplete(std::string const& source) const
+    {
+        for (std::size_t id = 0; id < kMessageCount; ++id)
+        {
+            if (!table->loaded[id])
+            {
+                throw std::runtime_error("Missing message " + std::string(kMessageKeys[id]) + " in " + source);
+            }
+
+            std::size_t argCount = table->messages[id].argCount();
+
+            if (argCount != kMessageArgs[id])
+            {
+                throw std::runtime_error("Message " + std::string(kMessageKeys[id]) + " in " + source + " uses " + std::to_string(argCount) +
+                                         " values, the game gives it " + std::to_string(kMessageArgs[id]));
+            }
+        }
+    }
+
+private:
+    struct Table
+    {
+        std::array<MessageTemplate, kMessageCount> messages;
+        std::bitset<kMessageCount> loaded;
+    };
+
+    void store(MessageId id, MessageTemplate message)
+    {
+        if (table.use_count() > 1)
+        {
+            table = std::make_shared<Table>(*table);
+        }
+
+        table->messages[static_cast<std::size_t>(id)] = std::move(message);
+        table->loaded[static_cast<std::size_t>(id)] = true;
+    }
+
+    static std::shared_ptr<Table> const& emptyTable()
+    {
+        static std::shared_ptr<Table> const empty = std::make_shared<Table>();
+        return empty;
+    }
+
+    std::shared_ptr<Table> table = emptyTable();
+};
 
 // used in utils.cpp
 
 typedef MinePosition(*EnterPosFn)(unsigned int, unsigned int, Player const&);
-typedef MinePosition(*RandomPosFn)(Width, Height);
+typedef MinePosition(*RandomPosFn)(Pcg32&, Width, Height);
 
-struct Player
+// Positions are kept in the board's own Position type (PackedPosition on the dense boards)
+
+template <typename BoardT>
+struct BasicPlayer
 {
+    unsigned int id = 0;  // creation order, stays the same when other players are eliminated
     std::string name;
     PlayerType type = PlayerType::None;
-    std::vector<MinePosition> placedMines;
-    std::vector<MinePosition> placedGuesses;
-    std::vector<MinePosition> minesHistory;
-    std::vector<MinePosition> guessesHistory;
+    std::vector<typename BoardT::Position> placedMines;
+    std::vector<typename BoardT::Position> placedGuesses;
+    std::vector<typename BoardT::Position> minesHistory;
+    std::vector<typename BoardT::Position> guessesHistory;
+    typename BoardT::CellSet guessedCells;  // mirrors guessesHistory
+    typename BoardT::CellSet ownMineCells;  // mirrors minesHistory
     MinesCount remainingMines{0};
     GuessesCount remainingGuesses{0};
     DetectedMines opponentMinesDetected{0};
     DetectedMines ownMinesDetected{0};
-    EnterMineFn enterMine = nullptr;
+    Pcg32 random;  // reseeded from GameContext::random every round, PC moves draw from it
+    void (*enterMine)(BasicGameContext<BoardT>&, BasicPlayer&) = nullptr;
 
-    bool operator==(Player const &other) const
+    bool operator==(BasicPlayer const &other) const
     {
         return (name == other.name);
     }
 };
 
-struct State
+template <typename BoardT>
+struct BasicState
+{
+    BasicState (*updateFunction)(BasicGameContext<BoardT>&) = nullptr;
+};
+
+// Board size limits asked for in stateEnteringBoardMeasures. They default to BoardConfig::Limits
+// and can be changed at runtime; the dense Board needs width * height <= kMaxDenseCells,
+// larger fields go through SparseBoard
+
+struct BoardLimits
 {
-    StateUpdateFn updateFunction = nullptr;
+    int minWidth = BoardConfig::Limits::kMinWidth;
+    int maxWidth = BoardConfig::Limits::kMaxdWidth;
+    int minHeight = BoardConfig::Limits::kMinHeight;
+    int maxHeight = BoardConfig::Limits::kMaxHeight;
 };
 
-struct GameContext
+/*
+    A game on BoardT. GameStates and the utils game rules are written over it, so the interactive
+    game (GameContext, on a Board), batch games on fields too big for a Board (on a SparseBoard) and
+    tournament presets (FixedGameContext, on a FixedBoard) play by the same rules
+*/
+
+template <typename BoardT>
+struct BasicGameContext
 {
-    State currentState;
+    BasicState<BoardT> currentState;
     Width width{0};
     Height height{0};
-    Board board;
+    BoardT board;
+    BoardLimits limits;
     Round round{1};
+    GameOutcome outcome = GameOutcome::None;
     MinesCount mines{0};
     MinesCount initialMines{0};
-    Players players;
+    BasicPlayers<BoardT> players;
     Language language;
+    std::shared_ptr<LanguagePack const> languages;  // every language of the game, stateChangeLanguage switches between them
+    std::shared_ptr<OutputSink> output = std::make_shared<StdoutSink>();
+    Pcg32 random;
+    std::shared_ptr<ThreadPool> workers;  // when set, PC moves of a round are computed on it concurrently
+    std::shared_ptr<DeltaRenderer> boardView;  // when set, boards are redrawn in place (see utils::board::showPerPlayer)
+    typename BoardT::CellCounts placementCounts;  // per-cell scratch for stateProcessingMines, all zero between rounds
 };
 
@@ -2,23 +2,73 @@
 
 #include "types.h"
 #include "constants.h"
+#include "game_input.h"
+#include "output.h"
+#include "task.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <format>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
+
+static_assert(static_cast<long long>(BoardConfig::Limits::kMaxdWidth) * BoardConfig::Limits::kMaxHeight <= BoardConfig::Limits::kMaxDenseCells,
+    "PackedPosition stores board indices in 16 bits");
 
 namespace utils
 {
 
+inline void print(OutputSink& output, std::string_view text)
+{
+    if (output.enabled())
+    {
+        output.write(text);
+    }
+}
+
+// Formats the message only when the sink is going to show it, into the sink's reused buffer.
+// The key must take as many values as are passed, which is checked at compile time
+
+template <typename... Args>
+void printMessage(OutputSink& output, Language& language, std::type_identity_t<CheckedMessageId<Args...>> key, Args&&... args)
+{
+    if (!output.enabled())
+    {
+        return;
+    }
+
+    std::string& text = output.messageBuffer();
+    language.message(key.id).formatTo(text, args...);
+    output.write(text);
+}
+
+/*
+    Prompts that read player input come in pairs: a coroutine taking the GameInput to co_await,
+    and the blocking overload the console game uses, which runs the coroutine over std::cin
+*/
+
+template <typename T, typename U>
+Task<T> enterValue(OutputSink& output, GameInput& input, U message)
+{
+    utils::print(output, message);
+    output.flush();
+    co_return co_await input.read<T>();
+}
+
 template <typename T, typename U>
-T enterValue(U message)
+T enterValue(OutputSink& output, U message)
 {
-    T value;
-    std::cout << message;
-    std::cin >> value;
-    return value;
+    GameInput console(std::cin);
+    return runBlocking(utils::enterValue<T>(output, console, std::move(message)));
 }
 
 template <typename T>
@@ -28,30 +78,49 @@ bool isInRange(T value, T min, T max)
 }
 
 template <typename T>
-T enterValueInRange(Language& language, std::string const& message, T min, T max)
+Task<T> enterValueInRange(Language& language, OutputSink& output, GameInput& input, std::type_identity_t<CheckedMessageId<T, T>> message, T min, T max)
 {
-    std::string msgWithMinMax = std::vformat(std::string(message), std::make_format_args(min, max));
-    T value = utils::enterValue<T>(msgWithMinMax);
+    std::string msgWithMinMax = language.message(message.id).format(min, max);
+    T value = co_await utils::enterValue<T>(output, input, msgWithMinMax);
 
     while (!utils::isInRange(value, min, max))
     {
-        std::string msg = language["utilsMsg::kTryAgain"] + msgWithMinMax;
-        value = utils::enterValue<T>(msg);
+        std::string msg = language.message(MessageId::utilsMsg_kTryAgain).format() + msgWithMinMax;
+        value = co_await utils::enterValue<T>(output, input, msg);
     }
 
-    return value;
+    co_return value;
 }
 
-unsigned int getRandomNumberInRange(int max); 
+template <typename T>
+T enterValueInRange(Language& language, OutputSink& output, std::type_identity_t<CheckedMessageId<T, T>> message, T min, T max)
+{
+    GameInput console(std::cin);
+    return runBlocking(utils::enterValueInRange(language, output, console, message, min, max));
+}
+
+unsigned int getRandomNumberInRange(Pcg32& random, int max);
+
+/*
+    The game rules are templates over the board (see BasicGameContext) and are defined at the end of
+    this file. Setup and input that only the interactive game has stay on Board and GameContext
+*/
 
 namespace game
 {
 
-void enterMine(GameContext& context, Player& player);
-bool hasOnePlayer(Language& language, Players const& players);
-void handleOwnMine(Language& language, Player& player, MinePosition const& mine, Board& board);
-void handleOpponentMine(Language& language, Player& player, MinePosition const& mine, Board& board, Players const& players);
-void handleMiss(Language& language, Player const& player, MinePosition const& mine, Board& board);
+template <typename BoardT> Task<void> enterMine(BasicGameContext<BoardT>& context, GameInput& input, BasicPlayer<BoardT>& player);
+template <typename BoardT> void enterMine(BasicGameContext<BoardT>& context, BasicPlayer<BoardT>& player);
+template <typename BoardT> void commitMine(BasicGameContext<BoardT>& context, BasicPlayer<BoardT>& player, MinePosition const& minePosition);
+template <typename BoardT> void placeMines(BasicGameContext<BoardT>& context, BasicPlayer<BoardT>& player, std::vector<MinePosition> const& positions);
+template <typename BoardT> std::vector<std::vector<MinePosition>> computePCMoves(BasicGameContext<BoardT>& context, unsigned int count);
+template <typename BoardT> GuessResult classifyGuess(BoardT const& board, BasicPlayer<BoardT> const& player, typename BoardT::Position const& guess);
+template <typename BoardT> std::vector<std::vector<GuessResult>> classifyGuesses(BasicGameContext<BoardT>& context);
+template <typename BoardT> bool hasOnePlayer(Language& language, OutputSink& output, BasicPlayers<BoardT> const& players);
+template <typename BoardT> void handleOwnMine(Language& language, OutputSink& output, BasicPlayer<BoardT>& player, MinePosition const& mine, BoardT& board);
+template <typename BoardT> void handleOpponentMine(Language& language, OutputSink& output, BasicPlayer<BoardT>& player, MinePosition const& mine, BoardT& board, BasicPlayers<BoardT> const& players);
+template <typename BoardT> void handleMiss(Language& language, OutputSink& output, BasicPlayer<BoardT> const& player, MinePosition const& mine, BoardT& board);
+template <typename BoardT> std::vector<MinePosition> findCollisions(BoardT const& board, BasicPlayers<BoardT> const& players, typename BoardT::CellCounts& placementCounts);
 
 } // namespace game
 
@@ -59,18 +128,21 @@ namespace player
 {
 
 Player getPCPlayer(Language& language, MinesCount initialMines);
-void addPlayers(Language& language, Players& players, MinesCount initialMines);
+Task<void> addPlayers(Language& language, OutputSink& output, GameInput& input, Players& players, MinesCount initialMines);
+void addPlayers(Language& language, OutputSink& output, Players& players, MinesCount initialMines);
 bool nameExists(std::string const& name, std::vector<Player> const& players);
-char getType(Language& language, std::string const& name);
-Player createPlayer(std::string const& name, MinesCount initialMines, char type);
-void saveMines(Player& player);
-void saveGuesses(Player& player);
-Player const* getTopScorer(Language& language, Players const& players);
-bool areThereWinners(Language& language, Players const& winners);
-Players getRemainigPlayers(Players const& players, Players const& removed);
-int countOpponentMines(Player const& player, Players const& players);
+Task<char> getType(Language& language, OutputSink& output, GameInput& input, std::string name);
+char getType(Language& language, OutputSink& output, std::string const& name);
+template <typename BoardT = Board> BasicPlayer<BoardT> createPlayer(std::string const& name, MinesCount initialMines, char type);
+template <typename BoardT> void saveMines(BasicPlayer<BoardT>& player, BoardT const& board);
+template <typename BoardT> void saveGuesses(BasicPlayer<BoardT>& player, BoardT const& board);
+template <typename BoardT> BasicPlayer<BoardT> const* getTopScorer(Language& language, OutputSink& output, BasicPlayers<BoardT> const& players);
+template <typename BoardT> bool areThereWinners(Language& language, OutputSink& output, BasicPlayers<BoardT> const& winners);
+template <typename BoardT> BasicPlayers<BoardT> getRemainigPlayers(BasicPlayers<BoardT> const& players, BasicPlayers<BoardT> const& removed);
+template <typename BoardT> int countOpponentMines(BasicPlayer<BoardT> const& player, BasicPlayers<BoardT> const& players);
+template <typename BoardT> BasicPlayer<BoardT> const* findById(BasicPlayers<BoardT> const& players, unsigned int id);
 bool isMineFromPlayer(MinePosition const& guess, std::vector<MinePosition> const& minePositions);
-GuessesCount whoHasLessAvailableMines(Players const& players);
+template <typename BoardT> GuessesCount whoHasLessAvailableMines(BasicPlayers<BoardT> const& players);
 
 } // namespace players
 
@@ -78,16 +150,793 @@ namespace board
 {
 
 int getStateValue(PositionState state);
-bool hasEmptyPositions(Width width, Height height, Board const& board);
-bool isFull(Language& language, Width width, Height height, Board const& board, Players const& players);
-void printPerPlayer(Width width, Height height, Board const& board, Player const& player);
-MinePosition getRandomBoardPosition(Width width, Height height);
-MinePosition enterBoardPosition(Language& language, Width width, Height height, Player const& player, RandomPosFn randomPos);
+bool hasEmptyPositions(Board const& board);
+void enablePlanes(Board& board);
+unsigned int countState(Board const& board, PositionState state);
+unsigned int countEmptyInRow(Board const& board, unsigned int y);
+void enableRangeIndex(Board& board);
+unsigned int countStateInArea(Board const& board, PositionState state, MinePosition const& from, MinePosition const& to);
+template <typename BoardT> bool isFull(Language& language, OutputSink& output, BoardT const& board, BasicPlayers<BoardT> const& players);
+MinePosition getRandomBoardPosition(Pcg32& random, Width width, Height height);
+template <typename BoardT> MinePosition getRandomFreePosition(Pcg32& random, BoardT const& board);
+template <typename BoardT> std::vector<MinePosition> pickFreePositions(Pcg32& random, BoardT const& board, unsigned int count);
+template <typename BoardT> Task<MinePosition> enterBoardPosition(Language& language, OutputSink& output, GameInput& input, Pcg32& random, Width width, Height height, BasicPlayer<BoardT> const& player, RandomPosFn randomPos);
+template <typename BoardT> MinePosition enterBoardPosition(Language& language, OutputSink& output, Pcg32& random, Width width, Height height, BasicPlayer<BoardT> const& player, RandomPosFn randomPos);
 std::string showInvalidBoardPositionStateReason(Language& language, PositionState const& state);
 bool isInvalidBoardPositionState(PositionState const& state);
-MinePosition validBoardPositionState(Language& language, Width width, Height height, Player const& player);
+template <typename BoardT> Task<std::optional<MinePosition>> validBoardPositionState(Language& language, OutputSink& output, GameInput& input, Pcg32& random, BoardT const& board, BasicPlayer<BoardT> const& player);
+template <typename BoardT> std::optional<MinePosition> validBoardPositionState(Language& language, OutputSink& output, Pcg32& random, BoardT const& board, BasicPlayer<BoardT> const& player);
 void initialize(Board& board, Height height, Width width);
 
+// Throws std::invalid_argument for limits a dense board can't be initialized within
+
+void checkLimits(BoardLimits const& limits);
+
+/*
+    How the board would look like:
+
+       0  1  2  3 ... (x)
+    0  0  0  0  0 ...
+    1  1  1  0  0 ...
+    2  0  0  0  0 ...
+    3  0  0  0  0 ...
+    .. .. .. .. .. ...
+    (y)
+
+    renderPerPlayer is shared by Board, FixedBoard and BoardSnapshot. printPerPlayer posts it to the
+    sink over a snapshot, so an AsyncSink can build the frame while the game moves on. The frame is
+    put together from ready-made glyphs in the sink's reused buffer, exactly as std::setw would
+    have padded every number, and written out at once
+*/
+
+// Every number up to Display::kBoardColWidth digits, right-aligned in a column, built at compile time
+
+constexpr unsigned int numbersWithDigits(std::size_t digits)
+{
+    unsigned int count = 1;
+
+    for (std::size_t digit = 0; digit < digits; ++digit)
+    {
+        count *= 10;
+    }
+
+    return count;
+}
+
+struct FrameGlyphs
+{
+    static constexpr std::size_t kWidth = Display::kBoardColWidth;
+    static constexpr unsigned int kCount = numbersWithDigits(kWidth);
+
+    constexpr FrameGlyphs()
+    {
+        for (unsigned int number = 0; number < kCount; ++number)
+        {
+            unsigned int rest = number;
+
+            for (std::size_t column = kWidth; column-- > 0;)
+            {
+                bool blank = (rest == 0 && column + 1 < kWidth);
+                text[number * kWidth + column] = blank ? ' ' : static_cast<char>('0' + rest % 10);
+                rest /= 10;
+            }
+        }
+    }
+
+    // A number too wide for its column is written as it is, std::setw does not cut it either
+
+    void append(std::string& frame, unsigned int number) const
+    {
+        if (number < kCount)
+        {
+            frame.append(&text[number * kWidth], kWidth);
+        }
+        else
+        {
+            frame.append(std::to_string(number));
+        }
+    }
+
+    std::array<char, kCount * kWidth> text{};
+};
+
+inline constexpr FrameGlyphs kFrameGlyphs;
+
+// The cell states a frame needs, copied out of a board
+
+struct BoardSnapshot
+{
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<PositionState> cells;
+
+    std::size_t size() const
+    {
+        return cells.size();
+    }
+
+    std::size_t index(unsigned int x, unsigned int y) const
+    {
+        return static_cast<std::size_t>(y) * width + x;
+    }
+
+    PositionState operator[](std::size_t cellIndex) const
+    {
+        return cells[cellIndex];
+    }
+};
+
+// If the player has guessed this position (empty, mine, or own mine), show its actual state value.
+// If the player has placed a mine here but hasn't guessed it, show '1'.
+// Otherwise, show '0'.
+
+inline unsigned int displayedValue(PositionState state, bool guessed, bool ownMine)
+{
+    if (guessed || state == PositionState::Removed)
+    {
+        return static_cast<unsigned int>(getStateValue(state));
+    }
+
+    return ownMine ? 1 : 0;
+}
+
+template <typename BoardT, typename CellSetT>
+void renderPerPlayer(std::string& frame, BoardT const& board, CellSetT const& guessedCells, CellSetT const& ownMineCells)
+{
+    std::size_t const lineLength = (static_cast<std::size_t>(board.width) + 1) * FrameGlyphs::kWidth + 1;
+
+    frame.clear();
+    frame.reserve((static_cast<std::size_t>(board.height) + 1) * lineLength);
+    frame.append(FrameGlyphs::kWidth, ' ');
+
+    for (unsigned int x = 0; x < board.width; ++x)
+    {
+        kFrameGlyphs.append(frame, x);
+    }
+
+    frame.push_back('\n');
+
+    for (unsigned int y = 0; y < board.height; ++y)
+    {
+        kFrameGlyphs.append(frame, y);
+
+        for (std::size_t cell = board.index(0, y); cell < board.index(0, y + 1); ++cell)
+        {
+            kFrameGlyphs.append(frame, displayedValue(board[cell], guessedCells.test(cell), ownMineCells.test(cell)));
+        }
+
+        frame.push_back('\n');
+    }
+}
+
+template <typename BoardT, typename CellSetT>
+std::string formatPerPlayer(BoardT const& board, CellSetT const& guessedCells, CellSetT const& ownMineCells)
+{
+    std::string frame;
+    renderPerPlayer(frame, board, guessedCells, ownMineCells);
+    return frame;
+}
+
+template <typename BoardT>
+BoardSnapshot takeSnapshot(BoardT const& board)
+{
+    BoardSnapshot snapshot{board.width, board.height, {}};
+    snapshot.cells.reserve(board.size());
+
+    for (std::size_t cell = 0; cell < board.size(); ++cell)
+    {
+        snapshot.cells.push_back(board[cell]);
+    }
+
+    return snapshot;
+}
+
+template <typename BoardT, typename PlayerT>
+void printPerPlayer(OutputSink& output, BoardT const& board, PlayerT const& player)
+{
+    if (!output.enabled())
+    {
+        return;
+    }
+
+    output.post([snapshot = takeSnapshot(board), guessed = player.guessedCells, own = player.ownMineCells](std::string& frame)
+    {
+        renderPerPlayer(frame, snapshot, guessed, own);
+    });
+}
+
+// printPerPlayer, or the in-place redraw when the context has a DeltaRenderer
+
+void showPerPlayer(GameContext& context, Player const& player);
+
+// Games on the other boards are played headless and have no DeltaRenderer
+
+template <typename BoardT>
+void showPerPlayer(BasicGameContext<BoardT>& context, BasicPlayer<BoardT> const& player)
+{
+    printPerPlayer(*context.output, context.board, player);
+}
+
+} // namespace board
+
+} // namespace utils
+
+// Definitions of the game rule templates declared above
+
+namespace utils
+{
+
+namespace game
+{
+
+template <typename BoardT>
+void commitMine(BasicGameContext<BoardT>& context, BasicPlayer<BoardT>& player, MinePosition const& minePosition)
+{
+    context.board.placeMine(minePosition.x, minePosition.y, player.id, context.round.getValue());
+
+    utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kSuccessMessage, player.name, minePosition.x, minePosition.y);
+
+    player.placedMines.push_back(context.board.pack(minePosition));
+}
+
+template <typename BoardT>
+Task<void> enterMine(BasicGameContext<BoardT>& context, GameInput& input, BasicPlayer<BoardT>& player)
+{
+    if (context.board.empty())
+    {
+        utils::printMessage(*context.output, context.language, MessageId::utilsMsg_kEmptyBoard);
+    }
+
+    if (player.type == PlayerType::PC)
+    {
+        placeMines(context, player, utils::board::pickFreePositions(player.random, context.board, context.mines.getValue()));
+        co_return;
+    }
+
+    for (unsigned int i = 0; i < context.mines.getValue(); i++)
+    {
+        unsigned int iPlus1 = i + 1;
+        utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kMessage, iPlus1, context.mines.getValue());
+
+        std::optional<MinePosition> minePosition = co_await utils::board::validBoardPositionState(context.language, *context.output, input, player.random, context.board, player);
+
+        if (!minePosition)
+        {
+            break;
+        }
+
+        commitMine(context, player, *minePosition);
+    }
+
+    utils::player::saveMines(player, context.board);
+}
+
+template <typename BoardT>
+void enterMine(BasicGameContext<BoardT>& context, BasicPlayer<BoardT>& player)
+{
+    GameInput console(std::cin);
+    runBlocking(enterMine(context, console, player));
+}
+
+// Commits moves that were picked beforehand, with the same messages enterMine shows
+
+template <typename BoardT>
+void placeMines(BasicGameContext<BoardT>& context, BasicPlayer<BoardT>& player, std::vector<MinePosition> const& positions)
+{
+    for (unsigned int i = 0; i < positions.size(); i++)
+    {
+        unsigned int iPlus1 = i + 1;
+        utils::printMessage(*context.output, context.language, MessageId::PuttingMines_kMessage, iPlus1, context.mines.getValue());
+
+        commitMine(context, player, positions[i]);
+    }
+
+    utils::player::saveMines(player, context.board);
+}
+
+/*
+    Placements and guesses within a round are simultaneous, and a PC pick only reads the free-cell
+    pool, which neither placing a mine nor guessing changes. So every PC player's picks for the round
+    can be drawn up front from its own generator, on context.workers when there is one.
+    The result is indexed like context.players, human players get an empty list
+*/
+
+template <typename BoardT>
+std::vector<std::vector<MinePosition>> computePCMoves(BasicGameContext<BoardT>& context, unsigned int count)
+{
+    std::vector<std::vector<MinePosition>> moves(context.players.size());
+
+    for (std::size_t i = 0; i < context.players.size(); ++i)
+    {
+        if (context.players[i].type != PlayerType::PC)
+        {
+            continue;
+        }
+
+        if (context.workers)
+        {
+            context.workers->submit([&context, &moves, count, i](unsigned int)
+            {
+                moves[i] = utils::board::pickFreePositions(context.players[i].random, context.board, count);
+            });
+        }
+        else
+        {
+            moves[i] = utils::board::pickFreePositions(context.players[i].random, context.board, count);
+        }
+    }
+
+    if (context.workers)
+    {
+        context.workers->wait();
+    }
+
+    return moves;
+}
+
+template <typename BoardT>
+GuessResult classifyGuess(BoardT const& board, BasicPlayer<BoardT> const& player, typename BoardT::Position const& guess)
+{
+    // If the mine is from the player, it reduces the amount of mines it can place
+
+    if (player.ownMineCells.test(guess.index))
+    {
+        return GuessResult::OwnMine;
+    }
+
+    return (board[guess.index] == PositionState::WithMine) ? GuessResult::OpponentMine : GuessResult::Miss;
+}
+
+/*
+    Read-only first half of stateProcessingGuesses: every player's guesses are classified against
+    the board as it is when the phase starts, one player per task on context.workers when there is one.
+    The merge then has to re-check guesses on cells an earlier guess of the same phase changed
+*/
+
+template <typename BoardT>
+std::vector<std::vector<GuessResult>> classifyGuesses(BasicGameContext<BoardT>& context)
+{
+    std::vector<std::vector<GuessResult>> results(context.players.size());
+
+    auto classify = [&context, &results](std::size_t i)
+    {
+        BasicPlayer<BoardT> const& player = context.players[i];
+        results[i].reserve(player.placedGuesses.size());
+
+        for (auto const& guess : player.placedGuesses)
+        {
+            results[i].push_back(classifyGuess(context.board, player, guess));
+        }
+    };
+
+    for (std::size_t i = 0; i < context.players.size(); ++i)
+    {
+        if (context.workers)
+        {
+            context.workers->submit([&classify, i](unsigned int) { classify(i); });
+        }
+        else
+        {
+            classify(i);
+        }
+    }
+
+    if (context.workers)
+    {
+        context.workers->wait();
+    }
+
+    return results;
+}
+
+template <typename BoardT>
+bool hasOnePlayer(Language& language, OutputSink& output, BasicPlayers<BoardT> const& players)
+{
+    if (players.size() > 1)
+    {
+        return false;
+    }
+
+    utils::printMessage(output, language, MessageId::Results_kHeaderGameOver);
+
+    if (players.size() == 1)
+    {
+        utils::printMessage(output, language, MessageId::Results_kWinnerByElimination, players[0].name);
+    }
+    else
+    {
+        utils::printMessage(output, language, MessageId::Results_kNoPlayersRemainingTie);
+    }
+
+    return true;
+}
+
+template <typename BoardT>
+void handleOwnMine(Language& language, OutputSink& output, BasicPlayer<BoardT>& player, MinePosition const& mine, BoardT& board)
+{
+    if (board.empty())
+    {
+        utils::printMessage(output, language, MessageId::utilsMsg_kEmptyBoard);
+    }
+
+    utils::printMessage(output, language, MessageId::ProcessingGuesses_kHitOwnMine, player.name, mine.x, mine.y);
+    player.ownMinesDetected.setValue(player.ownMinesDetected.getValue() + 1);
+
+    if (player.remainingMines.getValue() > 0)
+    {
+        utils::printMessage(output, language, MessageId::ProcessingGuesses_kMinesRemaining, player.remainingMines.getValue());
+        player.remainingMines.setValue(player.remainingMines.getValue() - 1);
+        board.setState(mine.x, mine.y, PositionState::Removed);
+    }
+}
+
+template <typename BoardT>
+void handleOpponentMine(Language& language, OutputSink& output, BasicPlayer<BoardT>& player, MinePosition const& mine, BoardT& board, BasicPlayers<BoardT> const& players)
+{
+    if (board.empty())
+    {
+        utils::printMessage(output, language, MessageId::utilsMsg_kEmptyBoard);
+    }
+
+    if (players.empty())
+    {
+        utils::printMessage(output, language, MessageId::utilsMsg_kEmptyPlayers);
+    }
+
+    // If the position has a mine, the player detected a mine from other player
+
+    utils::printMessage(output, language, MessageId::ProcessingGuesses_kHitOpponentMine, player.name, mine.x, mine.y);
+    player.opponentMinesDetected.setValue(player.opponentMinesDetected.getValue() + 1);
+    board.setState(mine.x, mine.y, PositionState::GuessedMine);
+
+    // The cell remembers who committed the mine, the owner is only named if it's still playing
+
+    BasicPlayer<BoardT> const* opponent = utils::player::findById(players, board.owner(mine.x, mine.y));
+
+    if (opponent != nullptr && opponent->id != player.id)
+    {
+        utils::printMessage(output, language, MessageId::ProcessingGuesses_kItWasPlayersMine, opponent->name);
+    }
+}
+
+template <typename BoardT>
+void handleMiss(Language& language, OutputSink& output, BasicPlayer<BoardT> const& player, MinePosition const& mine, BoardT& board)
+{
+    if (board.empty())
+    {
+        utils::printMessage(output, language, MessageId::utilsMsg_kEmptyBoard);
+    }
+
+    utils::printMessage(output, language, MessageId::ProcessingGuesses_kMiss, player.name, mine.x, mine.y);
+    board.setState(mine.x, mine.y, PositionState::GuessedEmpty);
+}
+
+/*
+    Collisions are found with a counting pass over the linear cell indices:
+    the first pass counts how many placed mines land in every cell, the second one
+    walks the mines again in player order, reports the first mine of every cell counted
+    more than once and clears the count so the scratch buffer is zeroed for the next round
+*/
+
+template <typename BoardT>
+std::vector<MinePosition> findCollisions(BoardT const& board, BasicPlayers<BoardT> const& players, typename BoardT::CellCounts& placementCounts)
+{
+    placementCounts.resize(board.size(), 0);
+
+    for (auto const& player : players)
+    {
+        for (auto const& mine : player.placedMines)
+        {
+            ++placementCounts[mine.index];
+        }
+    }
+
+    std::vector<MinePosition> collisions;
+
+    for (auto const& player : players)
+    {
+        for (auto const& mine : player.placedMines)
+        {
+            unsigned int& count = placementCounts[mine.index];
+
+            if (count > 1)
+            {
+                collisions.push_back(board.unpack(mine));
+            }
+
+            count = 0;
+        }
+    }
+
+    return collisions;
+}
+
+} // namespace game
+
+namespace player
+{
+
+template <typename BoardT>
+BasicPlayer<BoardT> createPlayer(std::string const& name, MinesCount initialMines, char type)
+{
+    BasicPlayer<BoardT> player;
+
+    player.name = name;
+    player.remainingMines = initialMines;
+    player.remainingGuesses.setValue(initialMines.getValue());
+    player.enterMine = &utils::game::enterMine<BoardT>;
+    player.type = (type == PlayerCreation::Options::kHuman) ? PlayerType::HumanPlayer : PlayerType::PC;
+
+    return player;
+}
+
+template <typename BoardT>
+void saveMines(BasicPlayer<BoardT>& player, BoardT const& board)
+{
+    player.ownMineCells.reserveCells(board.size());
+
+    for (auto const& mine : player.placedMines)
+    {
+        player.minesHistory.push_back(mine);
+        player.ownMineCells.set(mine.index);
+    }
+}
+
+template <typename BoardT>
+void saveGuesses(BasicPlayer<BoardT>& player, BoardT const& board)
+{
+    player.guessedCells.reserveCells(board.size());
+
+    for (auto const& mine : player.placedGuesses)
+    {
+        player.guessesHistory.push_back(mine);
+        player.guessedCells.set(mine.index);
+    }
+}
+
+template <typename BoardT>
+BasicPlayer<BoardT> const* getTopScorer(Language& language, OutputSink& output, BasicPlayers<BoardT> const& players)
+{
+    BasicPlayer<BoardT> const* topPlayer = nullptr;
+
+    unsigned int maxScore = 0;
+
+    for (auto const& player : players)
+    {
+        unsigned int score = player.opponentMinesDetected.getValue() - player.ownMinesDetected.getValue();
+
+        utils::printMessage(output, language, MessageId::Results_kScoreOfPlayer, player.name, score);
+
+        if (score > maxScore)
+        {
+            maxScore = score;
+            topPlayer = &player;
+        }
+    }
+
+    return topPlayer;
+}
+
+template <typename BoardT>
+bool areThereWinners(Language& language, OutputSink& output, BasicPlayers<BoardT> const& winners)
+{
+    if (winners.empty())
+    {
+        return false;
+    }
+
+    utils::printMessage(output, language, MessageId::Results_kHeaderGameOverWinner);
+
+    if (winners.size() == 1)
+    {
+        utils::printMessage(output, language, MessageId::Results_kWinnerWins, winners[0].name);
+        utils::printMessage(output, language, MessageId::Results_kCongratulations);
+    }
+    else
+    {
+        utils::printMessage(output, language, MessageId::Results_kTie);
+        utils::printMessage(output, language, MessageId::Results_kWinnersListHeader);
+        for (auto const& winner : winners)
+        {
+            utils::printMessage(output, language, MessageId::Results_kWinnerListItem, winner.name);
+        }
+    }
+
+    return true;
+}
+
+template <typename BoardT>
+BasicPlayers<BoardT> getRemainigPlayers(BasicPlayers<BoardT> const& players, BasicPlayers<BoardT> const& removed)
+{
+    BasicPlayers<BoardT> result;
+
+    for (auto const& player : players)
+    {
+        if (std::find(removed.begin(), removed.end(), player) == removed.end())
+        {
+            result.push_back(player);
+        }
+    }
+
+    return result;
+}
+
+template <typename BoardT>
+int countOpponentMines(BasicPlayer<BoardT> const& player, BasicPlayers<BoardT> const& players)
+{
+    int totalOpponentMines = 0;
+
+    for (auto const& other : players)
+    {
+        if (other.name != player.name)
+        {
+            totalOpponentMines += other.placedMines.size();
+        }
+    }
+
+    return totalOpponentMines;
+}
+
+template <typename BoardT>
+BasicPlayer<BoardT> const* findById(BasicPlayers<BoardT> const& players, unsigned int id)
+{
+    // Players keep their creation order when others are eliminated, so they stay sorted by id
+
+    auto it = std::lower_bound(players.begin(), players.end(), id, [](BasicPlayer<BoardT> const& player, unsigned int value) { return player.id < value; });
+
+    if (it == players.end() || it->id != id)
+    {
+        return nullptr;
+    }
+
+    return &*it;
+}
+
+template <typename BoardT>
+GuessesCount whoHasLessAvailableMines(BasicPlayers<BoardT> const& players)
+{
+    GuessesCount lessGuesses{std::numeric_limits<unsigned int>::max()};
+    for (auto const& player : players)
+    {
+        if (player.remainingMines.getValue() < lessGuesses.getValue())
+        {
+            lessGuesses.setValue(player.remainingMines.getValue());
+        }
+    }
+    return lessGuesses;
+}
+
+} // namespace player
+
+namespace board
+{
+
+template <typename BoardT>
+bool isFull(Language& language, OutputSink& output, BoardT const& board, BasicPlayers<BoardT> const& players)
+{
+    bool const hasEmpty = board.count(PositionState::Empty) > 0;
+
+    // Every state change goes through setState, which keeps the counters right
+
+    if constexpr (std::is_same_v<BoardT, Board>)
+    {
+        assert(hasEmpty == utils::board::hasEmptyPositions(board));
+    }
+
+    if (hasEmpty)
+    {
+        return false;
+    }
+
+    // If the game ended because of the board being full,
+    // the winner is determined by the number of mines it guessed
+
+    utils::printMessage(output, language, MessageId::Results_kHeaderGameOverBoardFull);
+    utils::printMessage(output, language, MessageId::Results_kNoMorePositions);
+    utils::printMessage(output, language, MessageId::Results_kFinalScores);
+
+    BasicPlayer<BoardT> const* topPlayer = utils::player::getTopScorer(language, output, players);
+
+    if (topPlayer != nullptr)
+    {
+        utils::printMessage(output, language, MessageId::Results_kWinnerByPoints, topPlayer->name);
+    }
+
+    return true;
+}
+
+// Stops early when no cell is left to pick, e.g. when collisions removed the last free ones
+
+template <typename BoardT>
+std::vector<MinePosition> pickFreePositions(Pcg32& random, BoardT const& board, unsigned int count)
+{
+    std::vector<MinePosition> positions;
+    positions.reserve(count);
+
+    for (unsigned int i = 0; i < count && !board.freeCells.empty(); ++i)
+    {
+        MinePosition position = getRandomFreePosition(random, board);
+        position.state = PositionState::WithMine;
+        positions.push_back(position);
+    }
+
+    return positions;
+}
+
+template <typename BoardT>
+MinePosition getRandomFreePosition(Pcg32& random, BoardT const& board)
+{
+    assert(!board.freeCells.empty());
+
+    std::uint64_t cellIndex = board.freeCells.at(random.boundedWide(board.freeCells.size()));
+    return {static_cast<unsigned int>(cellIndex % board.width), static_cast<unsigned int>(cellIndex / board.width)};
+}
+
+template <typename BoardT>
+Task<MinePosition> enterBoardPosition(Language& language, OutputSink& output, GameInput& input, Pcg32& random, Width width, Height height, BasicPlayer<BoardT> const& player, RandomPosFn randomPos)
+{
+    MinePosition minePosition;
+    if (player.type == PlayerType::HumanPlayer)
+    {
+        auto xPos = co_await utils::enterValueInRange<unsigned int>(language, output, input, MessageId::utilsMsg_kEnterXValue, static_cast<unsigned int>(0), (width.getValue() - 1));
+        auto yPos = co_await utils::enterValueInRange<unsigned int>(language, output, input, MessageId::utilsMsg_kEnterYValue, static_cast<unsigned int>(0), (height.getValue() - 1));
+        minePosition = {xPos, yPos};
+    }
+    else if (player.type == PlayerType::PC)
+    {
+        minePosition = randomPos(random, width, height);
+    }
+    co_return minePosition;
+}
+
+template <typename BoardT>
+MinePosition enterBoardPosition(Language& language, OutputSink& output, Pcg32& random, Width width, Height height, BasicPlayer<BoardT> const& player, RandomPosFn randomPos)
+{
+    GameInput console(std::cin);
+    return runBlocking(enterBoardPosition(language, output, console, random, width, height, player, randomPos));
+}
+
+// Nobody gets a position once there is no free cell left, a human would be asked forever.
+// PC players draw straight from the free cells and never need a retry. A human entry is
+// checked against the board cell it points at
+
+template <typename BoardT>
+Task<std::optional<MinePosition>> validBoardPositionState(Language& language, OutputSink& output, GameInput& input, Pcg32& random, BoardT const& board, BasicPlayer<BoardT> const& player)
+{
+    if (board.freeCells.empty())
+    {
+        co_return std::nullopt;
+    }
+
+    if (player.type == PlayerType::PC)
+    {
+        MinePosition minePosition = getRandomFreePosition(random, board);
+        minePosition.state = PositionState::WithMine;
+        co_return minePosition;
+    }
+
+    Width width{unsigned{board.width}};
+    Height height{unsigned{board.height}};
+    MinePosition minePosition = co_await enterBoardPosition(language, output, input, random, width, height, player, getRandomBoardPosition);
+
+    while (isInvalidBoardPositionState(board.state(minePosition.x, minePosition.y)))
+    {
+        utils::print(output, showInvalidBoardPositionStateReason(language, board.state(minePosition.x, minePosition.y)));
+        minePosition = co_await enterBoardPosition(language, output, input, random, width, height, player, getRandomBoardPosition);
+    }
+
+    minePosition.state = PositionState::WithMine;
+
+    co_return minePosition;
+}
+
+template <typename BoardT>
+std::optional<MinePosition> validBoardPositionState(Language& language, OutputSink& output, Pcg32& random, BoardT const& board, BasicPlayer<BoardT> const& player)
+{
+    GameInput console(std::cin);
+    return runBlocking(validBoardPositionState(language, output, console, random, board, player));
+}
+
 } // namespace board
 
-} // namespace utils
\ No newline at end of file
+} // namespace utils
@@ -0,0 +1,86 @@
+# Turns the message tree of a language file into a MessageId enum, one entry per "Section::kKey",
+# plus the key of every ID so a language file can be loaded into a flat array, and the number of
+# values each message takes: one past its highest placeholder index, as MessageTemplate::argCount().
+# Runs at configure time; editing the language file triggers a reconfigure
+
+function(count_message_args text out_count)
+    string(REPLACE "{{" "" text "${text}")
+    string(REPLACE "}}" "" text "${text}")
+    string(REGEX MATCHALL "{[^{}]*}" placeholders "${text}")
+    set(count 0)
+    set(next_index 0)
+    foreach(placeholder IN LISTS placeholders)
+        # "{}" and "{:spec}" take the next value, "{1}" and "{1:spec}" the one they name
+        if (placeholder MATCHES "^{([0-9]+)")
+            set(index ${CMAKE_MATCH_1})
+        else()
+            set(index ${next_index})
+            math(EXPR next_index "${next_index} + 1")
+        endif()
+        if (NOT index LESS count)
+            math(EXPR count "${index} + 1")
+        endif()
+    endforeach()
+    set(${out_count} ${count} PARENT_SCOPE)
+endfunction(count_message_args)
+
+function(collect_message_keys json prefix out_keys out_args)
+    set(keys ${${out_keys}})
+    set(args ${${out_args}})
+    string(JSON member_count LENGTH "${json}")
+    if (member_count GREATER 0)
+        math(EXPR last_member "${member_count} - 1")
+        foreach(index RANGE ${last_member})
+            string(JSON member MEMBER "${json}" ${index})
+            string(JSON member_type TYPE "${json}" "${member}")
+            if (member_type STREQUAL "OBJECT")
+                string(JSON section GET "${json}" "${member}")
+                collect_message_keys("${section}" "${prefix}${member}::" keys args)
+            else()
+                string(JSON text GET "${json}" "${member}")
+                count_message_args("${text}" arg_count)
+                list(APPEND keys "${prefix}${member}")
+                list(APPEND args ${arg_count})
+            endif()
+        endforeach()
+    endif()
+    set(${out_keys} ${keys} PARENT_SCOPE)
+    set(${out_args} ${args} PARENT_SCOPE)
+endfunction(collect_message_keys)
+
+function(generate_message_ids language_file output_file)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${language_file}")
+    file(READ "${language_file}" json)
+
+    set(keys "")
+    set(args "")
+    collect_message_keys("${json}" "" keys args)
+    list(LENGTH keys key_count)
+
+    set(enum_entries "")
+    set(key_entries "")
+    foreach(key IN LISTS keys)
+        string(REPLACE "::" "_" enumerator "${key}")
+        string(APPEND enum_entries "    ${enumerator},\n")
+        string(APPEND key_entries "    \"${key}\",\n")
+    endforeach()
+
+    set(arg_entries "")
+    foreach(arg_count IN LISTS args)
+        string(APPEND arg_entries "    ${arg_count},\n")
+    endforeach()
+
+    get_filename_component(language_name "${language_file}" NAME)
+    set(content "#pragma once\n\n// Generated from ${language_name} by generate_message_ids.cmake, do not edit\n\n")
+    string(APPEND content "#include <cstddef>\n#include <string_view>\n\n")
+    string(APPEND content "enum class MessageId : unsigned short\n{\n${enum_entries}};\n\n")
+    string(APPEND content "inline constexpr std::size_t kMessageCount = ${key_count};\n\n")
+    string(APPEND content "// \"Section::kKey\" of every message, in MessageId order\n\n")
+    string(APPEND content "inline constexpr std::string_view kMessageKeys[kMessageCount] = {\n${key_entries}};\n\n")
+    string(APPEND content "// Values every message is formatted with, every language file has to use all of them\n\n")
+    string(APPEND content "inline constexpr std::size_t kMessageArgs[kMessageCount] = {\n${arg_entries}};\n")
+
+    file(WRITE "${output_file}.tmp" "${content}")
+    configure_file("${output_file}.tmp" "${output_file}" COPYONLY)
+    file(REMOVE "${output_file}.tmp")
+endfunction(generate_message_ids)
@@ -52,6 +52,36 @@ set_target_properties(nlohmann_json PROPERTIES FOLDER "_external/json/")
 # set(project_config_<subproject>_link_libraries "example") # Set libraries to be linked for a specific subproject
 # set(project_config_<subproject>_dependencies "example") # Set other targets as dependencies for a specific subproject
 
+# Message IDs come from the English texts (see cmake_utils/generate_message_ids.cmake)
+
+include("cmake_utils/generate_message_ids.cmake")
+generate_message_ids("${CMAKE_CURRENT_SOURCE_DIR}/../resources/${project_config_name}/en.json" "${CMAKE_BINARY_DIR}/generated/${project_config_name}/message_ids.h")
+include_directories("${CMAKE_BINARY_DIR}/generated")
+
+# Every language file is packed next to the executable, which reads only the pack (see language_pack.h).
+# The game writes the pack itself (--pack-languages). When cross-compiling it can't run on the build
+# machine: CMake runs it through CMAKE_CROSSCOMPILING_EMULATOR when there is one, otherwise a build
+# of the game for the build machine has to be given in MINEFIELD_HOST_PACKER
+
+set(MINEFIELD_HOST_PACKER "" CACHE FILEPATH "${project_config_name} built for the build machine, writes the language pack when cross-compiling without an emulator")
+
+set(language_packer ${project_config_name})
+if(CMAKE_CROSSCOMPILING AND NOT CMAKE_CROSSCOMPILING_EMULATOR)
+    if(NOT MINEFIELD_HOST_PACKER)
+        message(FATAL_ERROR "Cross-compiling ${project_config_name} needs CMAKE_CROSSCOMPILING_EMULATOR or MINEFIELD_HOST_PACKER to write the language pack")
+    endif()
+    set(language_packer "${MINEFIELD_HOST_PACKER}")
+endif()
+
+file(GLOB language_files "${CMAKE_CURRENT_SOURCE_DIR}/../resources/${project_config_name}/*.json")
+add_custom_target(${project_config_name}.languages ALL
+    COMMAND ${language_packer} --pack-languages "$<TARGET_FILE_DIR:${project_config_name}>/languages.pack" ${language_files}
+    DEPENDS ${language_files}
+    COMMENT "Packing the language files"
+    VERBATIM)
+add_dependencies(${project_config_name}.languages ${project_config_name})
+set_target_properties(${project_config_name}.languages PROPERTIES FOLDER "${project_config_name}.internals")
+
 set(link_libraries jngl)
 
 # set(project_config_extra_sources "someFile.cpp") # Extra sources that need to be compiled as part of the main project
@@ -59,5 +89,5 @@ set(link_libraries jngl)
 # set(project_config_unit_tests_extra_sources "../src/*.cpp") # Extra sources that need to be compiled as part of a tests project
 # set(project_config_unit_tests_extra_libraries "dbghelp") # Extra libraries that need to be linked as part of a tests project
 
-# set(project_config_benchmark_extra_sources "../src/*.cpp") # Extra sources that need to be compiled as part of a benchmark project
+set(project_config_benchmark_extra_sources "../src/${project_config_name}/*.cpp") # Extra sources that need to be compiled as part of a benchmark project
 # set(project_config_benchmark_extra_libraries "dbghelp") # Extra libraries that need to be linked as part of a benchmark project
@@ -1,14 +1,42 @@
+#include <minefield/delta_renderer.h>
 #include <minefield/game_states.h>
 #include <minefield/types.h>
 #include <minefield/utils.h>
 #include <minefield/json_utils.h>
+#include <minefield/language_pack.h>
+#include <minefield/mapped_file.h>
+#include <minefield/sharding.h>
+#include <minefield/simulation.h>
+#include <minefield/terminal.h>
+#include <minefield/tournament.h>
 
-void runMainLoop()
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+void runMainLoop(std::shared_ptr<LanguagePack const> pack, unsigned int seed, bool redraw)
 {
     bool quit = false;
     GameContext context;
-    context.language = json_utils::loadLanguage("../resources/minefield/en.json");
+    context.random.seed(seed);
+    context.output = std::make_shared<AsyncSink>(std::make_shared<StdoutSink>());
+    context.workers = std::make_shared<ThreadPool>();
+    context.language = pack->language(languages::codes::kEnglish);
+    context.languages = std::move(pack);
     context.currentState = { &GameStates::stateMainMenuUpdate };
+
+    if (redraw && terminal::enableEscapes())
+    {
+        context.boardView = std::make_shared<DeltaRenderer>();
+    }
+
     while (!quit)
     {
         if (context.currentState.updateFunction != nullptr)
@@ -17,16 +45,116 @@ void runMainLoop()
         }
         quit = context.currentState.updateFunction == nullptr;
     }
+
+    if (context.boardView)
+    {
+        context.output->post([view = context.boardView](std::string& frame) { view->close(frame); });
+    }
+}
+
+// --redraw keeps the boards in place at the top of the terminal and only rewrites changed cells
+
+bool hasFlag(int argc, char* argv[], std::string_view flag)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == flag)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// --seed S replays a game, otherwise every run starts from the clock
+
+unsigned int chooseSeed(int argc, char* argv[])
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--seed")
+        {
+            return static_cast<unsigned int>(std::strtoul(argv[i + 1], nullptr, 10));
+        }
+    }
+    return static_cast<unsigned int>(time(0));
+}
+
+// --pack-languages PACK FILE... is the build step writing the language pack, every language
+// named after its file ("en.json" is "en")
+
+bool isPackRequest(int argc, char* argv[])
+{
+    return argc >= 3 && std::string_view(argv[1]) == "--pack-languages";
+}
+
+int packLanguages(int argc, char* argv[])
+{
+    std::vector<std::pair<std::string, Language>> languages;
+
+    for (int i = 3; i < argc; ++i)
+    {
+        std::filesystem::path file = argv[i];
+        languages.emplace_back(file.stem().string(), json_utils::loadLanguage(file.string()));
+    }
+
+    LanguagePack::write(argv[2], languages);
+    return 0;
 }
 
-void initializeRandomNumberGenerator()
+int runBatchMode(LanguagePack const& pack, int argc, char* argv[])
 {
-    srand(static_cast<unsigned int>(time(0)));
+    Language language = pack.language(languages::codes::kEnglish);
+    StdoutSink output;
+
+    auto config = simulation::parseArguments(argc, argv);
+    if (!config)
+    {
+        utils::printMessage(output, language, MessageId::Simulation_kUsage);
+        return 1;
+    }
+
+    SimulationResults results;
+
+    if (config->processes > 0)
+    {
+        ShardOptions options;
+        options.processes = config->processes;
+        results = sharding::run(*config, language, output, options);
+    }
+    else
+    {
+        results = (config->threads == 1) ? simulation::runBatch(*config, language) : tournament::run(*config, language);
+    }
+    simulation::printReport(language, output, results);
+    return 0;
 }
 
-int main()
+int main(int argc, char* argv[])
 {
-    initializeRandomNumberGenerator();
-    runMainLoop();
+    try
+    {
+        if (isPackRequest(argc, argv))
+        {
+            return packLanguages(argc, argv);
+        }
+
+        // The pack is looked for next to the executable, whatever the working directory
+
+        auto pack = std::make_shared<LanguagePack const>(executableDirectory() / LanguagePack::kFileName);
+
+        if (simulation::isBatchRequest(argc, argv))
+        {
+            return runBatchMode(*pack, argc, argv);
+        }
+
+        runMainLoop(std::move(pack), chooseSeed(argc, argv), hasFlag(argc, argv, "--redraw"));
+    }
+    catch (std::runtime_error const& e)
+    {
+        // A language file or pack without every message, or no pack at all
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
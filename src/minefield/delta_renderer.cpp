@@ -0,0 +1,206 @@
+#include <minefield/delta_renderer.h>
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace
+{
+
+char const* const kSaveCursor = "\x1b" "7";
+char const* const kRestoreCursor = "\x1b" "8";
+char const* const kClearScreen = "\x1b[2J";
+char const* const kResetScrollRegion = "\x1b[r";
+
+void moveTo(std::string& frame, unsigned int row, unsigned int column)
+{
+    std::format_to(std::back_inserter(frame), "\x1b[{};{}H", row, column);
+}
+
+} // namespace
+
+void DeltaRenderer::render(std::string& frame, unsigned int playerId, std::string const& name, utils::board::BoardSnapshot const& board,
+                           CellBitmap const& guessedCells, CellBitmap const& ownMineCells, std::optional<TerminalSize> size)
+{
+    std::vector<std::uint8_t> values(board.size());
+
+    for (std::size_t cell = 0; cell < board.size(); ++cell)
+    {
+        values[cell] = static_cast<std::uint8_t>(utils::board::displayedValue(board[cell], guessedCells.test(cell), ownMineCells.test(cell)));
+    }
+
+    auto found = panels.find(playerId);
+    bool added = (found == panels.end());
+
+    if (added)
+    {
+        found = panels.emplace(playerId, Panel{}).first;
+    }
+
+    Panel& panel = found->second;
+    bool boardChanged = (panel.width != board.width || panel.height != board.height);
+    panel.name = name;
+    panel.width = board.width;
+    panel.height = board.height;
+
+    std::optional<Layout> fitting = size ? layoutFor(*size) : std::nullopt;
+
+    if (!fitting)
+    {
+        utils::board::renderPerPlayer(frame, board, guessedCells, ownMineCells);
+
+        if (paneSize)
+        {
+            frame.insert(0, kResetScrollRegion);
+            paneSize.reset();
+        }
+
+        panel.shown = std::move(values);
+        return;
+    }
+
+    if (added || boardChanged || paneSize != size)
+    {
+        panel.shown = std::move(values);
+        layout = *fitting;
+        redrawAll(frame, *size);
+        return;
+    }
+
+    updatePanel(frame, static_cast<std::size_t>(std::distance(panels.begin(), found)), panel, values);
+}
+
+void DeltaRenderer::close(std::string& frame)
+{
+    if (paneSize)
+    {
+        frame += kResetScrollRegion;
+        moveTo(frame, paneSize->rows, 1);
+        frame += '\n';
+        paneSize.reset();
+    }
+}
+
+// Panels sit side by side as far as the width allows, in bands of equal height
+
+std::optional<DeltaRenderer::Layout> DeltaRenderer::layoutFor(TerminalSize size) const
+{
+    Layout fitting;
+
+    for (auto const& [id, panel] : panels)
+    {
+        fitting.panelWidth = std::max(fitting.panelWidth, (panel.width + 1) * static_cast<unsigned int>(utils::board::FrameGlyphs::kWidth));
+        fitting.panelHeight = std::max(fitting.panelHeight, panel.height + 2);
+    }
+
+    if (fitting.panelWidth > size.columns)
+    {
+        return std::nullopt;
+    }
+
+    fitting.perBand = (size.columns + kPanelGap) / (fitting.panelWidth + kPanelGap);
+
+    unsigned int bands = (static_cast<unsigned int>(panels.size()) + fitting.perBand - 1) / fitting.perBand;
+    fitting.paneRows = bands * fitting.panelHeight;
+
+    if (fitting.paneRows + kMinLogRows > size.rows)
+    {
+        return std::nullopt;
+    }
+
+    return fitting;
+}
+
+void DeltaRenderer::redrawAll(std::string& frame, TerminalSize size)
+{
+    frame += kResetScrollRegion;
+    frame += kClearScreen;
+
+    std::size_t index = 0;
+
+    for (auto const& [id, panel] : panels)
+    {
+        drawPanel(frame, index++, panel);
+    }
+
+    std::format_to(std::back_inserter(frame), "\x1b[{};{}r", layout.paneRows + 1, size.rows);
+    moveTo(frame, layout.paneRows + 1, 1);
+
+    paneSize = size;
+}
+
+// Name on top, then the same rows printPerPlayer writes
+
+void DeltaRenderer::drawPanel(std::string& frame, std::size_t index, Panel const& panel) const
+{
+    unsigned int top = panelTop(index);
+    unsigned int left = panelLeft(index);
+
+    moveTo(frame, top, left);
+    frame.append(panel.name, 0, layout.panelWidth);
+
+    moveTo(frame, top + 1, left);
+    frame.append(utils::board::FrameGlyphs::kWidth, ' ');
+
+    for (unsigned int x = 0; x < panel.width; ++x)
+    {
+        utils::board::kFrameGlyphs.append(frame, x);
+    }
+
+    for (unsigned int y = 0; y < panel.height; ++y)
+    {
+        moveTo(frame, top + 2 + y, left);
+        utils::board::kFrameGlyphs.append(frame, y);
+
+        for (unsigned int x = 0; x < panel.width; ++x)
+        {
+            utils::board::kFrameGlyphs.append(frame, panel.shown[static_cast<std::size_t>(y) * panel.width + x]);
+        }
+    }
+}
+
+// Only the cells whose value changed, with the cursor put back where the messages left it
+
+void DeltaRenderer::updatePanel(std::string& frame, std::size_t index, Panel& panel, std::vector<std::uint8_t>& values) const
+{
+    unsigned int top = panelTop(index);
+    unsigned int left = panelLeft(index);
+    bool changed = false;
+
+    for (std::size_t cell = 0; cell < values.size(); ++cell)
+    {
+        if (values[cell] == panel.shown[cell])
+        {
+            continue;
+        }
+
+        if (!changed)
+        {
+            frame += kSaveCursor;
+            changed = true;
+        }
+
+        unsigned int x = static_cast<unsigned int>(cell % panel.width);
+        unsigned int y = static_cast<unsigned int>(cell / panel.width);
+
+        moveTo(frame, top + 2 + y, left + (x + 1) * static_cast<unsigned int>(utils::board::FrameGlyphs::kWidth));
+        utils::board::kFrameGlyphs.append(frame, values[cell]);
+    }
+
+    if (changed)
+    {
+        frame += kRestoreCursor;
+    }
+
+    panel.shown.swap(values);
+}
+
+unsigned int DeltaRenderer::panelTop(std::size_t index) const
+{
+    return 1 + static_cast<unsigned int>(index / layout.perBand) * layout.panelHeight;
+}
+
+unsigned int DeltaRenderer::panelLeft(std::size_t index) const
+{
+    return 1 + static_cast<unsigned int>(index % layout.perBand) * (layout.panelWidth + kPanelGap);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <minefield/delta_renderer.h>
+
+#include <string>
+
+namespace minefield::delta_renderer::tests
+{
+
+class DeltaRendererTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        utils::board::initialize(board, Height{2}, Width{3});
+        player.id = 0;
+        player.name = "Ann";
+        player.guessedCells.reserveCells(board.size());
+        player.ownMineCells.reserveCells(board.size());
+    }
+
+    std::string render(std::optional<TerminalSize> size)
+    {
+        std::string frame;
+        renderer.render(frame, player.id, player.name, utils::board::takeSnapshot(board), player.guessedCells, player.ownMineCells, size);
+        return frame;
+    }
+
+    Board board;
+    Player player;
+    DeltaRenderer renderer;
+    TerminalSize const terminal{24, 80};
+};
+
+TEST_F(DeltaRendererTestSuit, should_draw_the_whole_pane_first)
+{
+    std::string frame = render(terminal);
+
+    EXPECT_NE(frame.find("\x1b[2J"), std::string::npos);
+    EXPECT_NE(frame.find("\x1b[1;1HAnn"), std::string::npos);
+    EXPECT_NE(frame.find("\x1b[3;1H  0  0  0  0"), std::string::npos);
+    EXPECT_NE(frame.find("\x1b[5;24r"), std::string::npos);
+}
+
+TEST_F(DeltaRendererTestSuit, should_only_rewrite_changed_cells)
+{
+    render(terminal);
+
+    EXPECT_EQ(render(terminal), "");
+
+    board.setState(2, 1, PositionState::GuessedEmpty);
+    player.guessedCells.set(board.index(2, 1));
+
+    EXPECT_EQ(render(terminal), "\x1b" "7\x1b[4;10H  3\x1b" "8");
+}
+
+TEST_F(DeltaRendererTestSuit, should_draw_everything_again_when_the_terminal_is_resized)
+{
+    render(terminal);
+
+    std::string frame = render(TerminalSize{30, 100});
+
+    EXPECT_NE(frame.find("\x1b[2J"), std::string::npos);
+    EXPECT_NE(frame.find("\x1b[5;30r"), std::string::npos);
+}
+
+TEST_F(DeltaRendererTestSuit, should_write_full_frames_without_a_terminal_that_fits)
+{
+    std::string full = utils::board::formatPerPlayer(board, player.guessedCells, player.ownMineCells);
+
+    EXPECT_EQ(render(std::nullopt), full);
+    EXPECT_EQ(render(TerminalSize{5, 80}), full);
+
+    // Leaving a drawn pane gives the scrolling region back first
+
+    render(terminal);
+    EXPECT_EQ(render(TerminalSize{5, 80}), "\x1b[r" + full);
+}
+
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <minefield/fixed_board.h>
+#include <minefield/simulation.h>
+#include <minefield/utils.h>
+
+namespace minefield::fixed_board::tests
+{
+
+class FixedBoardTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        utils::board::initialize(runtimeBoard, Height{5}, Width{7});
+        utils::board::initialize(fixedBoard);
+    }
+
+    template <typename BoardT>
+    void play(BoardT& board, Player& player)
+    {
+        board.placeMine(6, 4, player.id, 1);
+        board.placeMine(2, 1, 1, 1);
+        board.setState(3, 3, PositionState::Removed);
+        board.setState(0, 4, PositionState::GuessedEmpty);
+
+        player.placedMines = {board.pack({6, 4, PositionState::WithMine})};
+        player.placedGuesses = {board.pack({0, 4, PositionState::WithMine})};
+        player.guessedCells = {};
+        player.ownMineCells = {};
+
+        // Both boards have the same size, so the bitmaps line up with either of them
+        utils::player::saveMines(player, runtimeBoard);
+        utils::player::saveGuesses(player, runtimeBoard);
+    }
+
+    Board runtimeBoard;
+    FixedBoard<7, 5> fixedBoard;
+};
+
+TEST_F(FixedBoardTestSuit, should_answer_scans_like_the_runtime_board)
+{
+    Player player;
+    play(runtimeBoard, player);
+    play(fixedBoard, player);
+
+    EXPECT_EQ(utils::board::hasEmptyPositions(fixedBoard), utils::board::hasEmptyPositions(runtimeBoard));
+    EXPECT_EQ(utils::board::countEmptyInRow(fixedBoard, 4), utils::board::countEmptyInRow(runtimeBoard, 4));
+
+    for (std::size_t state = 0; state < kPositionStateCount; ++state)
+    {
+        PositionState positionState = static_cast<PositionState>(state);
+        EXPECT_EQ(utils::board::countState(fixedBoard, positionState), utils::board::countState(runtimeBoard, positionState));
+        EXPECT_EQ(fixedBoard.count(positionState), runtimeBoard.count(positionState));
+    }
+}
+
+TEST_F(FixedBoardTestSuit, should_render_like_the_runtime_board)
+{
+    Player player;
+    play(runtimeBoard, player);
+
+    BufferSink runtimeView;
+    utils::board::printPerPlayer(runtimeView, runtimeBoard, player);
+
+    play(fixedBoard, player);
+
+    BufferSink fixedView;
+    utils::board::printPerPlayer(fixedView, fixedBoard, player);
+
+    EXPECT_EQ(fixedView.text(), runtimeView.text());
+}
+
+// A preset game has to end exactly where the same game ends on a Board
+
+template <typename PresetT>
+class PresetTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        language.set(MessageId::PlayerCreation_kPCName, "PC");
+        config.width.setValue(PresetT::BoardType::width);
+        config.height.setValue(PresetT::BoardType::height);
+        config.mines.setValue(PresetT::kInitialMines);
+        config.players = 3;
+        config.seed = 11;
+    }
+
+    Language language;
+    SimulationConfig config;
+};
+
+typedef ::testing::Types<TournamentPresets::Small, TournamentPresets::Large> Presets;
+TYPED_TEST_SUITE(PresetTestSuit, Presets);
+
+TYPED_TEST(PresetTestSuit, should_play_like_a_board)
+{
+    TypeParam preset;
+    preset.language = this->language;
+    preset.output = std::make_shared<NullSink>();
+
+    GameContext context;
+    context.language = this->language;
+    context.output = std::make_shared<NullSink>();
+
+    for (unsigned int game = 0; game < 20; ++game)
+    {
+        ::simulation::setupGame(context, this->config, game);
+        ::simulation::setupGame(preset, this->config, game);
+
+        EXPECT_EQ(::simulation::playGame(preset), ::simulation::playGame(context));
+        EXPECT_EQ(preset.round.getValue(), context.round.getValue());
+        EXPECT_EQ(preset.board.count(PositionState::Empty), context.board.count(PositionState::Empty));
+        ASSERT_EQ(preset.players.size(), context.players.size());
+
+        for (std::size_t i = 0; i < context.players.size(); ++i)
+        {
+            EXPECT_EQ(preset.players[i].id, context.players[i].id);
+            EXPECT_EQ(preset.players[i].remainingMines.getValue(), context.players[i].remainingMines.getValue());
+            EXPECT_EQ(preset.players[i].opponentMinesDetected.getValue(), context.players[i].opponentMinesDetected.getValue());
+            EXPECT_EQ(preset.players[i].ownMinesDetected.getValue(), context.players[i].ownMinesDetected.getValue());
+        }
+    }
+}
+
+} // namespace minefield::fixed_board::tests
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <minefield/utils.h>
 #include <minefield/game_states.h>
+#include <minefield/simulation.h>
 #include <iostream>
 
 namespace minefield::game::tests
@@ -12,16 +13,15 @@ protected:
     {
         Player player;
         player.name = name;
-        player.remainingMines = remainingMines;
+        player.remainingMines.setValue(remainingMines);
         context.players.push_back(player);
     }
 
     void setBoard(unsigned int width, unsigned int height) 
     {
-        context.board;
-        context.width = width;
-        context.height = height;
-        utils::board::initialize(context.board, context.width, context.height);
+        context.width.setValue(width);
+        context.height.setValue(height);
+        utils::board::initialize(context.board, context.height, context.width);
     }
 
     GameContext context;
@@ -34,7 +34,7 @@ TEST_F(GameTestSuit, should_continue_game_if_two_players_have_mines)
     addPlayer("p2",3);
     NextState nextState = GameStates::stateCheckingNextTurn(context);
 
-    EXPECT_EQ(nextState.updateFunction, GameStates::statePuttingMines);
+    EXPECT_EQ(nextState.updateFunction, &GameStates::statePuttingMines<Board>);
 }
 
 TEST_F(GameTestSuit, should_continue_game_if_at_least_two_players_have_mines)
@@ -46,7 +46,7 @@ TEST_F(GameTestSuit, should_continue_game_if_at_least_two_players_have_mines)
     addPlayer("p4", 0);
     NextState nextState = GameStates::stateCheckingNextTurn(context);
 
-    EXPECT_EQ(nextState.updateFunction, GameStates::statePuttingMines);
+    EXPECT_EQ(nextState.updateFunction, &GameStates::statePuttingMines<Board>);
 } 
 
 TEST_F(GameTestSuit, should_finish_game_if_board_is_not_initialized)
@@ -74,4 +74,57 @@ TEST_F(GameTestSuit, should_finish_game_if_players_are_not_initialized)
 
     EXPECT_EQ(nextState.updateFunction, nullptr);
 }
+
+// PC moves picked on a pool and frames rendered on the AsyncSink thread give the same game log
+
+std::string playLoggedGame(bool pipelined, unsigned int players = 4)
+{
+    SimulationConfig config;
+    config.players = players;
+    config.seed = 9;
+
+    auto log = std::make_shared<BufferSink>();
+
+    {
+        GameContext context;
+        context.language = {{MessageId::PlayerCreation_kPCName, "PC"},
+                            {MessageId::PuttingMines_kSuccessMessage, "{} placed a mine at ({}, {})\n"},
+                            {MessageId::GuessingMines_kSuccess, "{} guessed ({}, {})\n"},
+                            {MessageId::ProcessingGuesses_kScoreLine, "{}: {} {}\n"}};
+
+        if (pipelined)
+        {
+            context.output = std::make_shared<AsyncSink>(log);
+            context.workers = std::make_shared<ThreadPool>(4);
+        }
+        else
+        {
+            context.output = log;
+        }
+
+        simulation::setupGame(context, config, 0);
+        simulation::playGame(context);
+    }
+
+    return log->text();
+}
+
+TEST(PipelinedRoundsTestSuit, should_log_the_same_game_as_the_serial_rounds)
+{
+    std::string serial = playLoggedGame(false);
+
+    EXPECT_NE(serial.find("placed a mine"), std::string::npos);
+    EXPECT_EQ(playLoggedGame(true), serial);
+}
+
+// Many players guessing the same cells is where the merge has to re-check earlier changes
+
+TEST(PipelinedRoundsTestSuit, should_resolve_crowded_guesses_like_the_serial_rounds)
+{
+    std::string serial = playLoggedGame(false, 150);
+
+    EXPECT_NE(serial.find("PC150: "), std::string::npos);
+    EXPECT_EQ(playLoggedGame(true, 150), serial);
+}
+
 }
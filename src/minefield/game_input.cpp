@@ -0,0 +1,17 @@
+#include <minefield/game_input.h>
+
+#include <utility>
+
+void GameInput::push(std::string_view text)
+{
+    pending.append(text);
+    pending.push_back('\n');
+
+    if (waitingGame && resumeRead(*this, waitingRead))
+    {
+        std::coroutine_handle<> game = std::exchange(waitingGame, nullptr);
+        resumeRead = nullptr;
+        waitingRead = nullptr;
+        game.resume();
+    }
+}
@@ -0,0 +1,59 @@
+#include <minefield/game_scheduler.h>
+
+#include <algorithm>
+#include <utility>
+
+GameScheduler::GameId GameScheduler::start(GameContext context)
+{
+    GameId id = nextId++;
+
+    auto game = std::make_unique<Game>();
+    game->context = std::move(context);
+
+    if (game->context.currentState.updateFunction == nullptr)
+    {
+        game->context.currentState = { &GameStates::stateMainMenuUpdate };
+    }
+
+    game->task.emplace(GameStates::co::play(game->context, game->input));
+
+    Game& started = *game;
+    games.emplace(id, std::move(game));
+    started.task->start();
+
+    return id;
+}
+
+bool GameScheduler::deliver(GameId game, std::string_view line)
+{
+    auto found = games.find(game);
+
+    if (found == games.end() || found->second->task->done())
+    {
+        return false;
+    }
+
+    found->second->input.push(line);
+    return true;
+}
+
+bool GameScheduler::finished(GameId game) const
+{
+    auto found = games.find(game);
+    return found == games.end() || found->second->task->done();
+}
+
+GameContext const& GameScheduler::context(GameId game) const
+{
+    return games.at(game)->context;
+}
+
+std::size_t GameScheduler::activeGames() const
+{
+    return static_cast<std::size_t>(std::count_if(games.begin(), games.end(), [](auto const& entry) { return !entry.second->task->done(); }));
+}
+
+void GameScheduler::remove(GameId game)
+{
+    games.erase(game);
+}
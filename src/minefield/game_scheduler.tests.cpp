@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <minefield/game_scheduler.h>
+#include <minefield/game_states.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace minefield::game_scheduler::tests
+{
+
+// One human against the PC: a width out of range and an unknown player type are asked again,
+// then the human guesses its own three mines and is eliminated in the first round
+
+std::vector<std::string> const kScript = {"1", "5", "24", "24", "3", "Ann", "X", "H", "*",
+                                          "0", "0", "1", "0", "2", "0",
+                                          "0", "0", "1", "0", "2", "0"};
+
+GameContext newContext(std::shared_ptr<BufferSink> const& log)
+{
+    GameContext context;
+    context.random.seed(5);
+    context.output = log;
+    context.language = {{MessageId::MainMenu_kPrompt, "> "},
+                        {MessageId::BoardConfig_kEnterWidth, "width ({}-{}): "},
+                        {MessageId::BoardConfig_kEnterHeight, "height ({}-{}): "},
+                        {MessageId::MineConfig_kEnterMines, "mines ({}-{}): "},
+                        {MessageId::utilsMsg_kTryAgain, "again, "},
+                        {MessageId::PlayerCreation_kNamePrompt, "name ({} ends): "},
+                        {MessageId::PlayerCreation_kTypePrompt, "{} is {} or {}: "},
+                        {MessageId::PlayerCreation_kInvalidType, "{} or {}: "},
+                        {MessageId::PlayerCreation_kPCName, "PC"},
+                        {MessageId::utilsMsg_kEnterXValue, "x ({}-{}): "},
+                        {MessageId::utilsMsg_kEnterYValue, "y ({}-{}): "},
+                        {MessageId::PuttingMines_kSuccessMessage, "{} placed a mine at ({}, {})\n"},
+                        {MessageId::GuessingMines_kSuccess, "{} guessed ({}, {})\n"},
+                        {MessageId::ProcessingGuesses_kScoreLine, "{}: {} {}\n"}};
+    return context;
+}
+
+std::string playBlocking()
+{
+    std::string script;
+
+    for (auto const& line : kScript)
+    {
+        script += line + "\n";
+    }
+
+    auto log = std::make_shared<BufferSink>();
+    GameContext context = newContext(log);
+    context.currentState = { &GameStates::stateMainMenuUpdate };
+
+    std::istringstream input(script);
+    std::streambuf* stdinBuffer = std::cin.rdbuf(input.rdbuf());
+
+    while (context.currentState.updateFunction != nullptr)
+    {
+        context.currentState = (*context.currentState.updateFunction)(context);
+    }
+
+    std::cin.rdbuf(stdinBuffer);
+
+    return log->text();
+}
+
+TEST(GameSchedulerTestSuit, should_play_the_same_game_as_the_blocking_states)
+{
+    std::string blocking = playBlocking();
+    ASSERT_NE(blocking.find("Ann guessed (2, 0)"), std::string::npos);
+
+    auto log = std::make_shared<BufferSink>();
+    GameScheduler scheduler;
+    GameScheduler::GameId game = scheduler.start(newContext(log));
+
+    // The game waits at the main menu prompt until its first line arrives
+
+    EXPECT_FALSE(scheduler.finished(game));
+    EXPECT_EQ(log->text(), "\n> ");
+
+    for (auto const& line : kScript)
+    {
+        EXPECT_TRUE(scheduler.deliver(game, line));
+    }
+
+    EXPECT_TRUE(scheduler.finished(game));
+    EXPECT_EQ(scheduler.context(game).outcome, GameOutcome::Elimination);
+    EXPECT_EQ(log->text(), blocking);
+    EXPECT_FALSE(scheduler.deliver(game, "1"));
+}
+
+TEST(GameSchedulerTestSuit, should_keep_many_games_going_on_one_thread)
+{
+    std::string blocking = playBlocking();
+
+    unsigned int const games = 1000;
+
+    GameScheduler scheduler;
+    std::vector<std::shared_ptr<BufferSink>> logs;
+
+    for (unsigned int i = 0; i < games; ++i)
+    {
+        logs.push_back(std::make_shared<BufferSink>());
+        scheduler.start(newContext(logs.back()));
+    }
+
+    EXPECT_EQ(scheduler.activeGames(), games);
+
+    // Input arrives interleaved: every game gets a line before any gets the next one
+
+    for (auto const& line : kScript)
+    {
+        for (GameScheduler::GameId game = 0; game < games; ++game)
+        {
+            scheduler.deliver(game, line);
+        }
+    }
+
+    EXPECT_EQ(scheduler.activeGames(), 0u);
+
+    for (auto const& log : logs)
+    {
+        EXPECT_EQ(log->text(), blocking);
+    }
+}
+
+TEST(GameSchedulerTestSuit, should_keep_the_language_of_a_game_started_without_the_pack)
+{
+    auto log = std::make_shared<BufferSink>();
+    GameScheduler scheduler;
+    GameScheduler::GameId game = scheduler.start(newContext(log));
+
+    scheduler.deliver(game, std::to_string(MainMenu::Options::kLanguage));
+    scheduler.deliver(game, std::to_string(languages::options::kSpanish));
+
+    EXPECT_FALSE(scheduler.finished(game));
+    EXPECT_EQ(scheduler.context(game).language[MessageId::MainMenu_kPrompt], "> ");
+
+    scheduler.remove(game);
+}
+
+TEST(GameSchedulerTestSuit, should_take_values_the_way_a_stream_does)
+{
+    auto log = std::make_shared<BufferSink>();
+    GameScheduler scheduler;
+    GameScheduler::GameId game = scheduler.start(newContext(log));
+
+    // Several values on one line are taken one prompt at a time, and text where a number is
+    // expected reads as 0, an invalid menu option
+
+    scheduler.deliver(game, "abc");
+    scheduler.deliver(game, "1 24 24");
+
+    EXPECT_FALSE(scheduler.finished(game));
+    EXPECT_EQ(scheduler.context(game).width.getValue(), 24u);
+    EXPECT_EQ(scheduler.context(game).height.getValue(), 24u);
+
+    scheduler.remove(game);
+    EXPECT_TRUE(scheduler.finished(game));
+}
+
+}
@@ -1,4 +1,7 @@
+#include <format>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 #include <fstream>
@@ -12,7 +15,7 @@ nlohmann::json loadJson(std::string const& file)
     std::ifstream inputFile(file);
     if (!inputFile.is_open())
     {
-        std::cerr << "Could not open file " << file << '\n';
+        throw std::runtime_error("Could not open file " + file);
     }
 
     nlohmann::json data;
@@ -39,11 +42,35 @@ void addToDictionary(nlohmann::json const& data, Language& dictionary, std::stri
         {
             addToDictionary(el.value(), dictionary, currentKey);
         }
-        else
+        else if (auto id = findMessageId(currentKey))
+        {
+            dictionary.set(*id, el.value());
+        }
+    }
+}
+
+std::optional<MessageId> findMessageId(std::string_view key)
+{
+    static std::unordered_map<std::string_view, MessageId> const ids = []
+    {
+        std::unordered_map<std::string_view, MessageId> byKey;
+
+        for (std::size_t id = 0; id < kMessageCount; ++id)
         {
-            dictionary[currentKey] = el.value();
+            byKey.emplace(kMessageKeys[id], static_cast<MessageId>(id));
         }
+
+        return byKey;
+    }();
+
+    auto found = ids.find(key);
+
+    if (found == ids.end())
+    {
+        return std::nullopt;
     }
+
+    return found->second;
 }
 
 Language loadLanguage(std::string const& file)
@@ -59,11 +86,20 @@ Language loadLanguage(std::string const& file)
     {
         std::cerr << "Parse error: " << e.what() << std::endl;
     }
+    catch (std::format_error const& e)
+    {
+        throw std::runtime_error(std::string(e.what()) + " in " + file);
+    }
+    catch (std::runtime_error const&)
+    {
+        throw;
+    }
     catch (std::exception const& e)
     {
         std::cerr << "Error: " << e.what() << std::endl;
     }
 
+    dictionary.checkComplete(file);
     return dictionary;
 }
 
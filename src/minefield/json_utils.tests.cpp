@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <minefield/json_utils.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace minefield::json_utils::tests
+{
+
+// A language file with a text for every message but the skipped one, each using the values the
+// game gives it, except for the message given one value too many
+
+std::string writeLanguageFile(std::string const& path, std::size_t skipped = kMessageCount, std::size_t extraValue = kMessageCount)
+{
+    nlohmann::json data;
+
+    for (std::size_t id = 0; id < kMessageCount; ++id)
+    {
+        if (id == skipped)
+        {
+            continue;
+        }
+
+        std::string key(kMessageKeys[id]);
+        std::size_t separator = key.find("::");
+        std::string text = "text of " + key;
+
+        for (std::size_t arg = 0; arg < kMessageArgs[id] + (id == extraValue ? 1 : 0); ++arg)
+        {
+            text += " {}";
+        }
+
+        data[key.substr(0, separator)][key.substr(separator + 2)] = text;
+    }
+
+    std::ofstream(path) << data.dump();
+    return path;
+}
+
+TEST(loadLanguageTestSuit, should_index_every_message_by_its_id)
+{
+    std::string file = writeLanguageFile("language_complete.json");
+    Language language = ::json_utils::loadLanguage(file);
+    std::remove(file.c_str());
+
+    EXPECT_EQ(language[MessageId::MainMenu_kHeader], "text of MainMenu::kHeader");
+    EXPECT_EQ(language[MessageId::Simulation_kUsage], "text of Simulation::kUsage");
+}
+
+TEST(loadLanguageTestSuit, should_refuse_a_file_missing_a_message)
+{
+    std::string file = writeLanguageFile("language_incomplete.json", static_cast<std::size_t>(MessageId::Results_kHeader));
+
+    EXPECT_THROW(::json_utils::loadLanguage(file), std::runtime_error);
+    std::remove(file.c_str());
+}
+
+TEST(loadLanguageTestSuit, should_refuse_a_message_using_other_values_than_the_game_gives)
+{
+    std::string file = writeLanguageFile("language_extra_value.json", kMessageCount, static_cast<std::size_t>(MessageId::Results_kWinnerWins));
+
+    EXPECT_THROW(::json_utils::loadLanguage(file), std::runtime_error);
+    std::remove(file.c_str());
+}
+
+TEST(loadLanguageTestSuit, should_refuse_a_file_that_does_not_open)
+{
+    EXPECT_THROW(::json_utils::loadLanguage("no_such_language.json"), std::runtime_error);
+}
+
+TEST(loadLanguageTestSuit, should_only_know_the_generated_keys)
+{
+    EXPECT_EQ(::json_utils::findMessageId("PuttingMines::kHeader"), MessageId::PuttingMines_kHeader);
+    EXPECT_FALSE(::json_utils::findMessageId("PuttingMines::kNoSuchMessage").has_value());
+}
+
+}
@@ -0,0 +1,213 @@
+#include <minefield/language_pack.h>
+#include <minefield/mapped_file.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+
+std::uint32_t const kVersion = 1;
+char const kMagic[4] = {'M', 'F', 'L', 'P'};
+
+struct Header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t languageCount;
+    std::uint32_t messageCount;
+    std::uint32_t keysHash;
+};
+
+struct Entry
+{
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+// Swaps between the machine's byte order and the pack's little-endian one, both ways
+
+constexpr std::uint32_t littleEndian(std::uint32_t value)
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        return value;
+    }
+    else
+    {
+        return (value >> 24) | ((value >> 8) & 0xff00u) | ((value << 8) & 0xff0000u) | (value << 24);
+    }
+}
+
+Header littleEndian(Header header)
+{
+    header.version = littleEndian(header.version);
+    header.languageCount = littleEndian(header.languageCount);
+    header.messageCount = littleEndian(header.messageCount);
+    header.keysHash = littleEndian(header.keysHash);
+    return header;
+}
+
+Entry littleEndian(Entry entry)
+{
+    return {littleEndian(entry.offset), littleEndian(entry.length)};
+}
+
+// FNV-1a over every "Section::kKey" in MessageId order
+
+constexpr std::uint32_t hashMessageKeys()
+{
+    std::uint32_t hash = 2166136261u;
+
+    for (std::string_view key : kMessageKeys)
+    {
+        for (char c : key)
+        {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        hash = (hash ^ '\n') * 16777619u;
+    }
+
+    return hash;
+}
+
+template <typename T>
+void writeValue(std::ofstream& output, T const& value)
+{
+    output.write(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+} // namespace
+
+LanguagePack::LanguagePack(std::filesystem::path const& file)
+{
+    // The mapping stays for as long as a language uses it, the messages view their texts in place
+
+    auto mapped = std::make_shared<MappedFile const>(file);
+    std::string_view bytes = mapped->bytes();
+
+    auto damaged = [&file](char const* reason)
+    {
+        return std::runtime_error("Language pack " + file.string() + " " + reason + ", build the game again to write it");
+    };
+
+    Header header{};
+
+    if (bytes.size() < sizeof(header))
+    {
+        throw damaged("is truncated");
+    }
+
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header = littleEndian(header);
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion)
+    {
+        throw damaged("is not a language pack of this version");
+    }
+
+    if (header.messageCount != kMessageCount || header.keysHash != hashMessageKeys())
+    {
+        throw damaged("was built for other messages");
+    }
+
+    std::size_t const codesAt = sizeof(header);
+    std::size_t const indexAt = codesAt + std::size_t{header.languageCount} * kCodeSize;
+    std::size_t const tableAt = indexAt + std::size_t{header.languageCount} * kMessageCount * sizeof(Entry);
+
+    if (bytes.size() < tableAt)
+    {
+        throw damaged("is truncated");
+    }
+
+    languages.reserve(header.languageCount);
+
+    for (std::size_t index = 0; index < header.languageCount; ++index)
+    {
+        std::string_view code = bytes.substr(codesAt + index * kCodeSize, kCodeSize);
+        code = code.substr(0, code.find('\0'));
+
+        Language language;
+
+        for (std::size_t id = 0; id < kMessageCount; ++id)
+        {
+            Entry entry{};
+            std::memcpy(&entry, bytes.data() + indexAt + (index * kMessageCount + id) * sizeof(Entry), sizeof(entry));
+            entry = littleEndian(entry);
+
+            if (std::size_t{entry.offset} + entry.length > bytes.size() - tableAt)
+            {
+                throw damaged("is truncated");
+            }
+
+            language.set(static_cast<MessageId>(id), bytes.substr(tableAt + entry.offset, entry.length), mapped);
+        }
+
+        language.checkComplete(file.string() + " (" + std::string(code) + ")");
+        languages.emplace_back(std::string(code), std::move(language));
+    }
+}
+
+Language const& LanguagePack::language(std::string_view code) const
+{
+    auto found = std::find_if(languages.begin(), languages.end(), [code](auto const& entry) { return entry.first == code; });
+
+    if (found == languages.end())
+    {
+        throw std::runtime_error("No language " + std::string(code) + " in the language pack");
+    }
+
+    return found->second;
+}
+
+void LanguagePack::write(std::filesystem::path const& file, std::vector<std::pair<std::string, Language>> const& languages)
+{
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.languageCount = static_cast<std::uint32_t>(languages.size());
+    header.messageCount = static_cast<std::uint32_t>(kMessageCount);
+    header.keysHash = hashMessageKeys();
+
+    std::vector<Entry> index;
+    std::string table;
+
+    for (auto const& [code, language] : languages)
+    {
+        for (std::size_t id = 0; id < kMessageCount; ++id)
+        {
+            std::string_view text = language[static_cast<MessageId>(id)];
+            index.push_back(littleEndian(Entry{static_cast<std::uint32_t>(table.size()), static_cast<std::uint32_t>(text.size())}));
+            table += text;
+        }
+    }
+
+    std::ofstream output(file, std::ios::binary | std::ios::trunc);
+
+    if (!output)
+    {
+        throw std::runtime_error("Could not write " + file.string());
+    }
+
+    writeValue(output, littleEndian(header));
+
+    for (auto const& entry : languages)
+    {
+        char code[kCodeSize] = {};
+        entry.first.copy(code, kCodeSize - 1);
+        output.write(code, kCodeSize);
+    }
+
+    output.write(reinterpret_cast<char const*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(Entry)));
+    output.write(table.data(), static_cast<std::streamsize>(table.size()));
+
+    if (!output)
+    {
+        throw std::runtime_error("Could not write " + file.string());
+    }
+}
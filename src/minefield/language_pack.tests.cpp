@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <minefield/language_pack.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace minefield::language_pack::tests
+{
+
+// A language with a text for every message, each using the values the game gives it
+
+Language completeLanguage(std::string const& code)
+{
+    Language language;
+
+    for (std::size_t id = 0; id < kMessageCount; ++id)
+    {
+        std::string text = code + " " + std::string(kMessageKeys[id]);
+
+        for (std::size_t arg = 0; arg < kMessageArgs[id]; ++arg)
+        {
+            text += " {}";
+        }
+
+        language.set(static_cast<MessageId>(id), text);
+    }
+
+    return language;
+}
+
+class LanguagePackTestSuit : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        std::remove(kFile);
+    }
+
+    static constexpr char const* kFile = "languages_test.pack";
+};
+
+TEST_F(LanguagePackTestSuit, should_read_back_every_language_written)
+{
+    LanguagePack::write(kFile, {{"en", completeLanguage("en")}, {"fr", completeLanguage("fr")}});
+    LanguagePack pack(kFile);
+
+    EXPECT_EQ(pack.language("en")[MessageId::MainMenu_kHeader], "en MainMenu::kHeader");
+    EXPECT_EQ(pack.language("fr")[MessageId::Results_kWinnerWins], "fr Results::kWinnerWins {}");
+    EXPECT_EQ(pack.language("fr").message(MessageId::Results_kWinnerWins).format("Ann"), "fr Results::kWinnerWins Ann");
+    EXPECT_THROW(pack.language("de"), std::runtime_error);
+}
+
+// The texts are read in place from the mapped file, which has to stay for the languages taken
+// from the pack even once the pack is gone
+
+TEST_F(LanguagePackTestSuit, should_keep_the_texts_of_a_language_after_the_pack)
+{
+    LanguagePack::write(kFile, {{"en", completeLanguage("en")}});
+
+    Language language;
+    {
+        LanguagePack pack(kFile);
+        language = pack.language("en");
+    }
+
+    EXPECT_EQ(language[MessageId::MainMenu_kHeader], "en MainMenu::kHeader");
+    EXPECT_EQ(language.message(MessageId::Results_kWinnerWins).format("Ann"), "en Results::kWinnerWins Ann");
+}
+
+TEST_F(LanguagePackTestSuit, should_refuse_a_damaged_pack)
+{
+    LanguagePack::write(kFile, {{"en", completeLanguage("en")}});
+
+    std::string bytes;
+    {
+        std::ifstream input(kFile, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    std::ofstream(kFile, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+    EXPECT_THROW(LanguagePack{kFile}, std::runtime_error);
+
+    bytes[0] = 'X';
+    std::ofstream(kFile, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    EXPECT_THROW(LanguagePack{kFile}, std::runtime_error);
+
+    EXPECT_THROW(LanguagePack{"no_such_languages.pack"}, std::runtime_error);
+}
+
+TEST(LanguageTestSuit, should_share_the_texts_until_one_copy_changes)
+{
+    Language original{{MessageId::MainMenu_kPrompt, "> "}};
+    Language copy = original;
+
+    EXPECT_EQ(copy[MessageId::MainMenu_kPrompt].data(), original[MessageId::MainMenu_kPrompt].data());
+
+    copy.set(MessageId::MainMenu_kPrompt, ">> ");
+
+    EXPECT_EQ(original[MessageId::MainMenu_kPrompt], "> ");
+    EXPECT_EQ(copy[MessageId::MainMenu_kPrompt], ">> ");
+}
+
+}
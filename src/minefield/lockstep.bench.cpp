@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <minefield/lockstep.h>
+
+namespace lockstep::bench
+{
+
+// The same 64 games, one GameContext at a time against GameBatch::kLanes games in lockstep
+
+SimulationConfig createConfig(benchmark::State const& state)
+{
+    SimulationConfig config;
+    config.players = static_cast<unsigned int>(state.range(0));
+    config.games = 64;
+    config.seed = 1;
+    return config;
+}
+
+void scalarGames(benchmark::State& state)
+{
+    SimulationConfig config = createConfig(state);
+    Language language{{MessageId::PlayerCreation_kPCName, "PC"}};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(simulation::runBatch(config, language));
+    }
+}
+BENCHMARK(scalarGames)->ArgName("players")->Arg(2)->Arg(4)->Arg(8);
+
+void lockstepGames(benchmark::State& state)
+{
+    SimulationConfig config = createConfig(state);
+
+    for (auto _ : state)
+    {
+        SimulationResults results;
+        lockstep::playGames(config, 0, config.games, results);
+        benchmark::DoNotOptimize(results);
+    }
+}
+BENCHMARK(lockstepGames)->ArgName("players")->Arg(2)->Arg(4)->Arg(8);
+
+} // namespace lockstep::bench
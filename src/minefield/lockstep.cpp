@@ -0,0 +1,394 @@
+#include <minefield/lockstep.h>
+
+#include <minefield/utils.h>
+
+#include <algorithm>
+#include <climits>
+
+namespace lockstep
+{
+
+GameBatch::GameBatch(SimulationConfig const& config)
+: config(config)
+, cellCount(static_cast<std::size_t>(config.width.getValue()) * config.height.getValue())
+, players(config.players)
+{
+    cells.resize(cellCount * kLanes);
+    ownMines.resize(players * cellCount * kLanes);
+    placementCounts.resize(cellCount * kLanes);
+    placedMines.resize(players);
+    placedGuesses.resize(players);
+    mineCounts.resize(players * kLanes);
+    guessCounts.resize(players * kLanes);
+    remaining.resize(players * kLanes);
+    opponentDetected.resize(players * kLanes);
+    ownDetected.resize(players * kLanes);
+    alive.resize(players * kLanes);
+    playerRandoms.resize(players * kLanes);
+}
+
+void GameBatch::play(unsigned int firstGame, unsigned int games)
+{
+    reset(firstGame, games);
+
+    while (anyActive())
+    {
+        putMines();
+
+        if (!anyActive())
+        {
+            break;
+        }
+
+        processMines();
+        guessMines();
+        processGuesses();
+        checkNextTurn();
+    }
+}
+
+// Same starting point as simulation::setupGame, lanes past the requested games stay inactive
+
+void GameBatch::reset(unsigned int firstGame, unsigned int games)
+{
+    std::fill(cells.begin(), cells.end(), PositionState::Empty);
+    std::fill(ownMines.begin(), ownMines.end(), std::uint8_t{0});
+    std::fill(mineCounts.begin(), mineCounts.end(), 0u);
+    std::fill(guessCounts.begin(), guessCounts.end(), 0u);
+    std::fill(remaining.begin(), remaining.end(), config.mines.getValue());
+    std::fill(opponentDetected.begin(), opponentDetected.end(), 0u);
+    std::fill(ownDetected.begin(), ownDetected.end(), 0u);
+    std::fill(alive.begin(), alive.end(), std::uint8_t{1});
+
+    for (unsigned int player = 0; player < players; ++player)
+    {
+        placedMines[player].clear();
+        placedGuesses[player].clear();
+    }
+
+    for (unsigned int lane = 0; lane < kLanes; ++lane)
+    {
+        active[lane] = lane < games;
+        rounds[lane] = 1;
+        minesPerRound[lane] = config.mines.getValue();
+        emptyCounts[lane] = static_cast<unsigned int>(cellCount);
+        outcomes[lane] = GameOutcome::None;
+        pools[lane].reset(cellCount);
+        randoms[lane].seed(config.seed, firstGame + lane);
+    }
+}
+
+bool GameBatch::anyActive() const
+{
+    return std::any_of(active.begin(), active.end(), [](std::uint8_t lane) { return lane != 0; });
+}
+
+// Board::setState for one lane
+
+void GameBatch::setCell(unsigned int lane, std::size_t cell, PositionState state)
+{
+    PositionState& current = cells[cell * kLanes + lane];
+
+    if (isFreeState(current) != isFreeState(state))
+    {
+        if (isFreeState(state))
+        {
+            pools[lane].insert(cell);
+        }
+        else
+        {
+            pools[lane].remove(cell);
+        }
+    }
+
+    emptyCounts[lane] += (state == PositionState::Empty);
+    emptyCounts[lane] -= (current == PositionState::Empty);
+    current = state;
+}
+
+std::uint16_t GameBatch::drawFreeCell(unsigned int lane, Pcg32& random)
+{
+    FreeCellPool const& pool = pools[lane];
+    std::size_t slot = utils::getRandomNumberInRange(random, static_cast<int>(pool.size()));
+    return pool.cells[slot];
+}
+
+void GameBatch::append(std::vector<std::uint16_t>& rows, std::vector<unsigned int>& counts, unsigned int player, unsigned int lane, std::uint16_t cell)
+{
+    unsigned int& count = counts[slot(player, lane)];
+
+    if (rows.size() < static_cast<std::size_t>(count + 1) * kLanes)
+    {
+        rows.resize(static_cast<std::size_t>(count + 1) * kLanes, 0);
+    }
+
+    rows[static_cast<std::size_t>(count) * kLanes + lane] = cell;
+    ++count;
+}
+
+unsigned int GameBatch::maxRows(std::vector<unsigned int> const& counts, unsigned int player) const
+{
+    auto begin = counts.begin() + static_cast<std::ptrdiff_t>(slot(player, 0));
+    return *std::max_element(begin, begin + kLanes);
+}
+
+// statePuttingMines. Drawing is serial within a game, so this phase runs lane by lane
+
+void GameBatch::putMines()
+{
+    for (unsigned int lane = 0; lane < kLanes; ++lane)
+    {
+        if (!active[lane])
+        {
+            continue;
+        }
+
+        if (config.maxRounds > 0 && rounds[lane] > config.maxRounds)
+        {
+            active[lane] = 0;
+            continue;
+        }
+
+        if (rounds[lane] > 1)
+        {
+            unsigned int fewest = UINT_MAX;
+
+            for (unsigned int player = 0; player < players; ++player)
+            {
+                if (alive[slot(player, lane)])
+                {
+                    fewest = std::min(fewest, remaining[slot(player, lane)]);
+                }
+            }
+
+            if (fewest == 0)
+            {
+                outcomes[lane] = GameOutcome::NoAvailableMines;
+                active[lane] = 0;
+                continue;
+            }
+
+            minesPerRound[lane] = fewest;
+        }
+
+        for (unsigned int player = 0; player < players; ++player)
+        {
+            if (alive[slot(player, lane)])
+            {
+                playerRandoms[slot(player, lane)].seed(randoms[lane](), player);
+            }
+        }
+
+        for (unsigned int player = 0; player < players; ++player)
+        {
+            if (!alive[slot(player, lane)])
+            {
+                continue;
+            }
+
+            for (unsigned int i = 0; i < minesPerRound[lane]; ++i)
+            {
+                std::uint16_t cell = drawFreeCell(lane, playerRandoms[slot(player, lane)]);
+                setCell(lane, cell, PositionState::WithMine);
+                append(placedMines[player], mineCounts, player, lane, cell);
+                ownMines[(player * cellCount + cell) * kLanes + lane] = 1;
+            }
+        }
+
+        ++rounds[lane];
+    }
+}
+
+// stateProcessingMines: utils::game::findCollisions across the whole batch.
+// Masked-out rows add zero, so the counting pass has no branches
+
+void GameBatch::processMines()
+{
+    for (unsigned int player = 0; player < players; ++player)
+    {
+        std::vector<std::uint16_t> const& rows = placedMines[player];
+        unsigned int rowCount = maxRows(mineCounts, player);
+
+        for (unsigned int row = 0; row < rowCount; ++row)
+        {
+            for (unsigned int lane = 0; lane < kLanes; ++lane)
+            {
+                bool valid = active[lane] & alive[slot(player, lane)] & (row < mineCounts[slot(player, lane)]);
+                placementCounts[rows[row * kLanes + lane] * kLanes + lane] += valid;
+            }
+        }
+    }
+
+    for (unsigned int player = 0; player < players; ++player)
+    {
+        std::vector<std::uint16_t> const& rows = placedMines[player];
+        unsigned int rowCount = maxRows(mineCounts, player);
+
+        for (unsigned int row = 0; row < rowCount; ++row)
+        {
+            for (unsigned int lane = 0; lane < kLanes; ++lane)
+            {
+                bool valid = active[lane] & alive[slot(player, lane)] & (row < mineCounts[slot(player, lane)]);
+
+                if (!valid)
+                {
+                    continue;
+                }
+
+                std::size_t cell = rows[row * kLanes + lane];
+                std::uint16_t& count = placementCounts[cell * kLanes + lane];
+
+                if (count > 1)
+                {
+                    setCell(lane, cell, PositionState::Removed);
+                }
+
+                count = 0;
+            }
+        }
+    }
+}
+
+// stateGuessingMines
+
+void GameBatch::guessMines()
+{
+    for (unsigned int lane = 0; lane < kLanes; ++lane)
+    {
+        if (!active[lane])
+        {
+            continue;
+        }
+
+        for (unsigned int player = 0; player < players; ++player)
+        {
+            if (!alive[slot(player, lane)])
+            {
+                continue;
+            }
+
+            for (unsigned int i = 0; i < minesPerRound[lane] && !pools[lane].empty(); ++i)
+            {
+                append(placedGuesses[player], guessCounts, player, lane, drawFreeCell(lane, playerRandoms[slot(player, lane)]));
+            }
+        }
+    }
+}
+
+// stateProcessingGuesses. One guess row is classified for all lanes at once and the counters are
+// updated with masks; only the resulting cell changes go back through setCell, lane by lane
+
+void GameBatch::processGuesses()
+{
+    std::array<PositionState, kLanes> newStates{};
+    std::array<std::uint8_t, kLanes> writes{};
+
+    for (unsigned int player = 0; player < players; ++player)
+    {
+        std::vector<std::uint16_t> const& rows = placedGuesses[player];
+        unsigned int rowCount = maxRows(guessCounts, player);
+
+        for (unsigned int row = 0; row < rowCount; ++row)
+        {
+            for (unsigned int lane = 0; lane < kLanes; ++lane)
+            {
+                std::size_t const index = slot(player, lane);
+                std::size_t const cell = rows[row * kLanes + lane];
+
+                unsigned int const valid = active[lane] & alive[index] & (row < guessCounts[index]);
+                unsigned int const own = ownMines[(player * cellCount + cell) * kLanes + lane];
+                unsigned int const withMine = (cells[cell * kLanes + lane] == PositionState::WithMine);
+                unsigned int const canRemove = (remaining[index] > 0);
+
+                ownDetected[index] += valid & own;
+                remaining[index] -= valid & own & canRemove;
+                opponentDetected[index] += valid & (own ^ 1u) & withMine;
+
+                newStates[lane] = own ? PositionState::Removed : (withMine ? PositionState::GuessedMine : PositionState::GuessedEmpty);
+                writes[lane] = static_cast<std::uint8_t>(valid & ((own ^ 1u) | canRemove));
+            }
+
+            for (unsigned int lane = 0; lane < kLanes; ++lane)
+            {
+                if (writes[lane])
+                {
+                    setCell(lane, rows[row * kLanes + lane], newStates[lane]);
+                }
+            }
+        }
+    }
+}
+
+// stateCheckingNextTurn. Opponent mines are every other remaining player's placed mines,
+// so one per-lane total minus the player's own count replaces countOpponentMines
+
+void GameBatch::checkNextTurn()
+{
+    std::array<unsigned int, kLanes> totals{};
+    std::array<std::uint8_t, kLanes> winners{};
+    std::array<unsigned int, kLanes> survivors{};
+
+    for (unsigned int player = 0; player < players; ++player)
+    {
+        for (unsigned int lane = 0; lane < kLanes; ++lane)
+        {
+            totals[lane] += alive[slot(player, lane)] ? mineCounts[slot(player, lane)] : 0;
+        }
+    }
+
+    for (unsigned int player = 0; player < players; ++player)
+    {
+        for (unsigned int lane = 0; lane < kLanes; ++lane)
+        {
+            std::size_t const index = slot(player, lane);
+            unsigned int const opponentMines = totals[lane] - mineCounts[index];
+
+            winners[lane] |= alive[index] & (opponentDetected[index] >= opponentMines) & (opponentMines > 0);
+            alive[index] &= (remaining[index] > 0) | (active[lane] ^ 1u);
+            survivors[lane] += alive[index];
+        }
+    }
+
+    for (unsigned int lane = 0; lane < kLanes; ++lane)
+    {
+        if (!active[lane])
+        {
+            continue;
+        }
+
+        if (winners[lane])
+        {
+            outcomes[lane] = GameOutcome::Winners;
+        }
+        else if (survivors[lane] <= 1)
+        {
+            outcomes[lane] = (survivors[lane] == 0) ? GameOutcome::NoPlayersLeft : GameOutcome::Elimination;
+        }
+        else if (emptyCounts[lane] == 0)
+        {
+            outcomes[lane] = GameOutcome::BoardFull;
+        }
+
+        active[lane] = (outcomes[lane] == GameOutcome::None);
+    }
+}
+
+void playGames(SimulationConfig const& config, unsigned int firstGame, unsigned int games, SimulationResults& results)
+{
+    GameBatch batch(config);
+
+    for (unsigned int first = firstGame; first < firstGame + games; first += GameBatch::kLanes)
+    {
+        unsigned int lanes = std::min(GameBatch::kLanes, firstGame + games - first);
+        batch.play(first, lanes);
+
+        for (unsigned int lane = 0; lane < lanes; ++lane)
+        {
+            ++results.games;
+            results.rounds += batch.round(lane) - 1;
+            ++results.outcomes[static_cast<std::size_t>(batch.outcome(lane))];
+        }
+    }
+}
+
+} // namespace lockstep
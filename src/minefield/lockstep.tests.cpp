@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <minefield/lockstep.h>
+
+namespace minefield::lockstep::tests
+{
+
+class LockstepTestSuit : public ::testing::TestWithParam<unsigned int>
+{
+protected:
+    void SetUp() override
+    {
+        language.set(MessageId::PlayerCreation_kPCName, "PC");
+        config.players = GetParam();
+        config.seed = 5;
+    }
+
+    Language language;
+    SimulationConfig config;
+};
+
+// Every lane has to end exactly where GameStates ends for the same game index
+
+TEST_P(LockstepTestSuit, LanesMatchTheScalarGames)
+{
+    unsigned int const games = ::lockstep::GameBatch::kLanes + 5;
+    ::lockstep::GameBatch batch(config);
+
+    GameContext context;
+    context.language = language;
+    context.output = std::make_shared<NullSink>();
+
+    for (unsigned int first = 0; first < games; first += ::lockstep::GameBatch::kLanes)
+    {
+        unsigned int lanes = std::min(::lockstep::GameBatch::kLanes, games - first);
+        batch.play(first, lanes);
+
+        for (unsigned int lane = 0; lane < lanes; ++lane)
+        {
+            ::simulation::setupGame(context, config, first + lane);
+            GameOutcome outcome = ::simulation::playGame(context);
+
+            EXPECT_EQ(batch.outcome(lane), outcome);
+            EXPECT_EQ(batch.round(lane), context.round.getValue());
+            EXPECT_EQ(batch.emptyCells(lane), context.board.count(PositionState::Empty));
+
+            for (Player const& player : context.players)
+            {
+                EXPECT_TRUE(batch.isAlive(player.id, lane));
+                EXPECT_EQ(batch.remainingMines(player.id, lane), player.remainingMines.getValue());
+                EXPECT_EQ(batch.opponentMinesDetected(player.id, lane), player.opponentMinesDetected.getValue());
+                EXPECT_EQ(batch.ownMinesDetected(player.id, lane), player.ownMinesDetected.getValue());
+            }
+        }
+    }
+}
+
+TEST_P(LockstepTestSuit, BatchTotalsMatchTheScalarBatch)
+{
+    config.games = 100;
+    SimulationResults scalar = ::simulation::runBatch(config, language);
+    config.lockstep = true;
+    SimulationResults lockstep = ::simulation::runBatch(config, language);
+
+    EXPECT_EQ(lockstep.games, scalar.games);
+    EXPECT_EQ(lockstep.rounds, scalar.rounds);
+    EXPECT_EQ(lockstep.outcomes, scalar.outcomes);
+}
+
+TEST_P(LockstepTestSuit, RoundLimitStopsBothPathsAlike)
+{
+    config.games = 40;
+    config.maxRounds = 2;
+    SimulationResults scalar = ::simulation::runBatch(config, language);
+    config.lockstep = true;
+    SimulationResults lockstep = ::simulation::runBatch(config, language);
+
+    EXPECT_LE(scalar.rounds, 2ull * config.games);
+    EXPECT_EQ(lockstep.rounds, scalar.rounds);
+    EXPECT_EQ(lockstep.outcomes, scalar.outcomes);
+}
+
+INSTANTIATE_TEST_SUITE_P(Players, LockstepTestSuit, ::testing::Values(2u, 3u, 6u, 150u));
+
+} // namespace minefield::lockstep::tests
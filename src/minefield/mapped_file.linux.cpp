@@ -0,0 +1,55 @@
+#include <minefield/mapped_file.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+MappedFile::MappedFile(std::filesystem::path const& path)
+{
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    struct stat status{};
+
+    if (descriptor < 0 || fstat(descriptor, &status) != 0)
+    {
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+        throw std::runtime_error("Could not open " + path.string());
+    }
+
+    size = static_cast<std::size_t>(status.st_size);
+
+    if (size > 0)
+    {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (mapping == MAP_FAILED)
+        {
+            close(descriptor);
+            throw std::runtime_error("Could not map " + path.string());
+        }
+
+        data = mapping;
+    }
+
+    // The mapping stays valid once the descriptor is closed
+
+    close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+    {
+        munmap(const_cast<void*>(data), size);
+    }
+}
+
+std::filesystem::path executableDirectory()
+{
+    return std::filesystem::read_symlink("/proc/self/exe").parent_path();
+}
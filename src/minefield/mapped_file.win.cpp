@@ -0,0 +1,66 @@
+#include <minefield/mapped_file.h>
+
+#include <windows.h>
+
+#include <stdexcept>
+#include <vector>
+
+MappedFile::MappedFile(std::filesystem::path const& path)
+{
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize{};
+
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize))
+    {
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file);
+        }
+        throw std::runtime_error("Could not open " + path.string());
+    }
+
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+
+    if (size > 0)
+    {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void const* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+        // The view stays valid once both handles are closed
+
+        if (mapping != nullptr)
+        {
+            CloseHandle(mapping);
+        }
+
+        if (view == nullptr)
+        {
+            CloseHandle(file);
+            throw std::runtime_error("Could not map " + path.string());
+        }
+
+        data = view;
+    }
+
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+}
+
+std::filesystem::path executableDirectory()
+{
+    std::vector<wchar_t> path(MAX_PATH);
+
+    while (GetModuleFileNameW(nullptr, path.data(), static_cast<DWORD>(path.size())) == path.size())
+    {
+        path.resize(path.size() * 2);
+    }
+
+    return std::filesystem::path(path.data()).parent_path();
+}
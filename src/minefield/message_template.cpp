@@ -0,0 +1,127 @@
+#include <minefield/message_template.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+MessageTemplate::MessageTemplate(std::string text)
+{
+    auto owned = std::make_shared<std::string const>(std::move(text));
+    source = *owned;
+    storage = std::move(owned);
+    parse();
+}
+
+MessageTemplate::MessageTemplate(std::string_view text, std::shared_ptr<void const> storage)
+: storage(std::move(storage))
+, source(text)
+{
+    parse();
+}
+
+void MessageTemplate::parse()
+{
+    Piece piece;
+    bool automatic = false;
+    bool manual = false;
+    std::size_t nextArg = 0;
+
+    auto invalid = [this](char const* reason)
+    {
+        return std::format_error("Message \"" + std::string(source) + "\": " + reason);
+    };
+
+    // An escaped brace ends the run after its first brace, the next run starts past the second
+
+    auto endRunAtEscape = [&](std::size_t i)
+    {
+        piece.literalLength = i + 1 - piece.literalBegin;
+        pieces.push_back(piece);
+
+        piece = Piece{};
+        piece.literalBegin = i + 2;
+    };
+
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        char c = source[i];
+
+        if (c == '}')
+        {
+            if (i + 1 == source.size() || source[i + 1] != '}')
+            {
+                throw invalid("unmatched '}'");
+            }
+            endRunAtEscape(i++);
+            continue;
+        }
+
+        if (c != '{')
+        {
+            continue;
+        }
+
+        if (i + 1 < source.size() && source[i + 1] == '{')
+        {
+            endRunAtEscape(i++);
+            continue;
+        }
+
+        std::size_t close = source.find('}', i);
+        std::size_t open = source.find('{', i + 1);
+
+        if (close == std::string::npos || open < close)
+        {
+            throw invalid("placeholder not closed, or with nested braces");
+        }
+
+        std::string_view field = source.substr(i + 1, close - i - 1);
+        std::size_t colon = field.find(':');
+        std::string_view index = field.substr(0, colon);
+
+        if (index.empty())
+        {
+            automatic = true;
+            piece.arg = nextArg++;
+        }
+        else
+        {
+            manual = true;
+            piece.arg = 0;
+
+            for (char digit : index)
+            {
+                if (digit < '0' || digit > '9')
+                {
+                    throw invalid("placeholder index is not a number");
+                }
+                piece.arg = piece.arg * 10 + static_cast<std::size_t>(digit - '0');
+            }
+        }
+
+        if (automatic && manual)
+        {
+            throw invalid("automatic and numbered placeholders mixed");
+        }
+
+        if (colon != std::string_view::npos)
+        {
+            piece.specBegin = specs.size();
+            specs.append("{");
+            specs.append(field.substr(colon));
+            specs.append("}");
+            piece.specLength = specs.size() - piece.specBegin;
+        }
+
+        piece.literalLength = i - piece.literalBegin;
+        pieces.push_back(piece);
+        args = std::max(args, piece.arg + 1);
+
+        piece = Piece{};
+        piece.literalBegin = close + 1;
+        i = close;
+    }
+
+    piece.literalLength = source.size() - piece.literalBegin;
+    pieces.push_back(piece);
+}
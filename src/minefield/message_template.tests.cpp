@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <minefield/message_template.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace minefield::message_template::tests
+{
+
+TEST(MessageTemplateTestSuit, should_format_like_std_format)
+{
+    MessageTemplate message("{}: {} of {} mines, {:.1f}% {{done}}\n");
+
+    EXPECT_EQ(message.argCount(), 4u);
+    EXPECT_EQ(message.format(std::string("Ann"), 3, 4u, 75.0), std::format("{}: {} of {} mines, {:.1f}% {{done}}\n", "Ann", 3, 4u, 75.0));
+}
+
+TEST(MessageTemplateTestSuit, should_append_to_the_buffer)
+{
+    MessageTemplate message("({}, {})");
+    std::string text = "at ";
+
+    message.formatTo(text, 1, 2);
+
+    EXPECT_EQ(text, "at (1, 2)");
+}
+
+TEST(MessageTemplateTestSuit, should_count_numbered_placeholders_up_to_the_highest)
+{
+    MessageTemplate message("{1} before {0}, {1} again");
+
+    EXPECT_EQ(message.argCount(), 2u);
+    EXPECT_EQ(message.format('a', 'b'), "b before a, b again");
+}
+
+TEST(MessageTemplateTestSuit, should_format_a_text_it_views_in_place)
+{
+    auto storage = std::make_shared<std::string const>("{{{0}}} of {1:>3}}}");
+    MessageTemplate message(std::string_view(*storage), storage);
+
+    EXPECT_EQ(message.text().data(), storage->data());
+    EXPECT_EQ(message.format(5, 7), "{5} of   7}");
+}
+
+TEST(MessageTemplateTestSuit, should_refuse_invalid_texts)
+{
+    EXPECT_THROW(MessageTemplate("{"), std::format_error);
+    EXPECT_THROW(MessageTemplate("}"), std::format_error);
+    EXPECT_THROW(MessageTemplate("{} and {0}"), std::format_error);
+    EXPECT_THROW(MessageTemplate("{x}"), std::format_error);
+}
+
+TEST(MessageTemplateTestSuit, should_refuse_formatting_with_too_few_values)
+{
+    MessageTemplate message("{} and {}");
+
+    EXPECT_THROW(message.format(1), std::format_error);
+}
+
+}
@@ -0,0 +1,142 @@
+#include <minefield/output.h>
+
+#include <iostream>
+
+void StdoutSink::write(std::string_view text)
+{
+    std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void BufferSink::write(std::string_view text)
+{
+    mText.append(text);
+}
+
+std::string const& BufferSink::text() const
+{
+    return mText;
+}
+
+void BufferSink::clear()
+{
+    mText.clear();
+}
+
+bool NullSink::enabled() const
+{
+    return false;
+}
+
+void NullSink::write(std::string_view)
+{
+}
+
+void StdoutSink::flush()
+{
+    std::cout.flush();
+}
+
+AsyncSink::AsyncSink(std::shared_ptr<OutputSink> target)
+: mTarget(std::move(target))
+, mWorker(&AsyncSink::run, this)
+{
+}
+
+AsyncSink::~AsyncSink()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mQueued.notify_one();
+    mWorker.join();
+
+    mTarget->flush();
+}
+
+bool AsyncSink::enabled() const
+{
+    return mTarget->enabled();
+}
+
+void AsyncSink::write(std::string_view text)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::string copy;
+
+        if (!mSpareTexts.empty())
+        {
+            copy = std::move(mSpareTexts.back());
+            mSpareTexts.pop_back();
+        }
+
+        copy.assign(text);
+        mJobs.push_back({std::move(copy), nullptr});
+    }
+    mQueued.notify_one();
+}
+
+void AsyncSink::post(RenderJob render)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back({std::string(), std::move(render)});
+    }
+    mQueued.notify_one();
+}
+
+void AsyncSink::flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDrained.wait(lock, [this] { return mJobs.empty() && !mBusy; });
+    lock.unlock();
+
+    mTarget->flush();
+}
+
+// Jobs are taken one at a time, so the target sees them in the order they were queued
+
+void AsyncSink::run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        mQueued.wait(lock, [this] { return mStopping || !mJobs.empty(); });
+
+        if (mJobs.empty())
+        {
+            return; // stopping, and everything queued has been written
+        }
+
+        Job job = std::move(mJobs.front());
+        mJobs.pop_front();
+        mBusy = true;
+        lock.unlock();
+
+        if (job.render)
+        {
+            mFrame.clear();
+            job.render(mFrame);
+            mTarget->write(mFrame);
+        }
+        else
+        {
+            mTarget->write(job.text);
+        }
+
+        lock.lock();
+        mBusy = false;
+
+        if (!job.render)
+        {
+            mSpareTexts.push_back(std::move(job.text));
+        }
+
+        if (mJobs.empty())
+        {
+            mDrained.notify_all();
+        }
+    }
+}
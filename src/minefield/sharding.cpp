@@ -0,0 +1,75 @@
+#include <minefield/sharding.h>
+
+#include <atomic>
+#include <memory>
+
+namespace sharding
+{
+
+void writeRecord(GameRecord& record, GameOutcome outcome, unsigned int round)
+{
+    record.rounds = round - 1;
+    record.outcome = outcome;
+    std::atomic_ref<std::uint8_t>(record.done).store(1, std::memory_order_release);
+}
+
+bool isDone(GameRecord const& record)
+{
+    return std::atomic_ref<std::uint8_t>(const_cast<std::uint8_t&>(record.done)).load(std::memory_order_acquire) != 0;
+}
+
+// Plays the unfinished games of [first, first + count), writing each record as soon as its game ends
+
+void playShard(SimulationConfig const& config, Language const& language, GameRecord* records, unsigned int first, unsigned int count, unsigned int attempt, ShardFaults const& faults)
+{
+    GameContext context;
+    context.language = language;
+    context.output = std::make_shared<NullSink>();
+
+    GameHooks hooks;
+    hooks.skip = [&](unsigned int game)
+    {
+        if (isDone(records[game]))
+        {
+            return true;
+        }
+
+        if (faults.beforeGame)
+        {
+            faults.beforeGame(game, attempt);
+        }
+        return false;
+    };
+    hooks.played = [records](unsigned int game, GameOutcome outcome, unsigned int round)
+    {
+        writeRecord(records[game], outcome, round);
+    };
+
+    simulation::playGames(context, config, first, count, hooks);
+}
+
+SimulationResults run(SimulationConfig const& config, Language& language, OutputSink& output, ShardOptions const& options)
+{
+    return run(config, language, output, options, ShardFaults{});
+}
+
+SimulationResults collectRecords(GameRecord const* records, unsigned int games)
+{
+    SimulationResults results;
+
+    for (unsigned int game = 0; game < games; ++game)
+    {
+        if (!isDone(records[game]))
+        {
+            continue;
+        }
+
+        ++results.games;
+        results.rounds += records[game].rounds;
+        ++results.outcomes[static_cast<std::size_t>(records[game].outcome)];
+    }
+
+    return results;
+}
+
+} // namespace sharding
@@ -0,0 +1,178 @@
+#include <minefield/sharding.h>
+
+#include <minefield/tournament.h>
+#include <minefield/utils.h>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace sharding
+{
+
+struct Shard
+{
+    unsigned int first = 0;
+    unsigned int count = 0;
+    unsigned int attempt = 0;
+    pid_t pid = -1;
+};
+
+bool isSupported()
+{
+    return true;
+}
+
+// The worker is pinned to one CPU, keeping its board and records local to that core's node
+
+pid_t startWorker(SimulationConfig const& config, Language const& language, GameRecord* records, Shard const& shard, unsigned int index, unsigned int cpu, ShardFaults const& faults)
+{
+    bool const failed = faults.failFork && faults.failFork(index, shard.attempt);
+    pid_t pid = failed ? -1 : fork();
+
+    if (pid != 0)
+    {
+        return pid;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    sched_setaffinity(0, sizeof(cpus), &cpus);
+
+    int status = 0;
+
+    try
+    {
+        playShard(config, language, records, shard.first, shard.count, shard.attempt, faults);
+    }
+    catch (...)
+    {
+        status = 1;
+    }
+
+    _exit(status); // skips the parent's atexit handlers and buffered output copied by fork
+}
+
+// Forks the shard's current attempt, or the next ones while fork() fails (e.g. EAGAIN once the
+// process table is full). False once every attempt is used up, the shard is then given up
+
+bool startShard(SimulationConfig const& config, Language& language, OutputSink& output, GameRecord* records, Shard& shard, unsigned int index, unsigned int cpu, ShardOptions const& options, ShardFaults const& faults)
+{
+    unsigned int const last = shard.first + shard.count - 1;
+
+    while (true)
+    {
+        shard.pid = startWorker(config, language, records, shard, index, cpu, faults);
+
+        if (shard.pid > 0)
+        {
+            return true;
+        }
+
+        if (++shard.attempt >= options.attempts)
+        {
+            utils::printMessage(output, language, MessageId::Simulation_kShardFailed, shard.first, last, shard.attempt);
+            return false;
+        }
+
+        utils::printMessage(output, language, MessageId::Simulation_kShardRetry, index, shard.first, last);
+    }
+}
+
+SimulationResults run(SimulationConfig const& config, Language& language, OutputSink& output, ShardOptions const& options, ShardFaults const& faults)
+{
+    unsigned int const cpuCount = std::max(1u, std::thread::hardware_concurrency());
+    unsigned int processes = (options.processes == 0) ? cpuCount : options.processes;
+    processes = std::max(1u, std::min(processes, config.games));
+
+    std::size_t const bytes = sizeof(GameRecord) * config.games;
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (region == MAP_FAILED)
+    {
+        SimulationConfig inProcess = config;
+        inProcess.threads = processes;
+        return tournament::run(inProcess, language);
+    }
+
+    GameRecord* records = static_cast<GameRecord*>(region);
+    std::uninitialized_default_construct_n(records, config.games);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Shard> shards(processes);
+    unsigned int running = 0;
+
+    for (unsigned int i = 0; i < processes; ++i)
+    {
+        shards[i].first = static_cast<unsigned int>(static_cast<unsigned long long>(config.games) * i / processes);
+        shards[i].count = static_cast<unsigned int>(static_cast<unsigned long long>(config.games) * (i + 1) / processes) - shards[i].first;
+        running += startShard(config, language, output, records, shards[i], i, i % cpuCount, options, faults);
+    }
+
+    while (running > 0)
+    {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+
+        if (pid < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        auto shard = std::find_if(shards.begin(), shards.end(), [pid](Shard const& s) { return s.pid == pid; });
+
+        if (shard == shards.end())
+        {
+            continue;
+        }
+
+        --running;
+        shard->pid = -1;
+
+        // A worker that exits cleanly has written all its records, anything else gets checked
+
+        GameRecord* begin = records + shard->first;
+        bool finished = std::all_of(begin, begin + shard->count, isDone);
+
+        if (finished)
+        {
+            continue;
+        }
+
+        unsigned int last = shard->first + shard->count - 1;
+        unsigned int index = static_cast<unsigned int>(shard - shards.begin());
+
+        if (++shard->attempt < options.attempts)
+        {
+            utils::printMessage(output, language, MessageId::Simulation_kShardRetry, index, shard->first, last);
+            running += startShard(config, language, output, records, *shard, index, index % cpuCount, options, faults);
+        }
+        else
+        {
+            utils::printMessage(output, language, MessageId::Simulation_kShardFailed, shard->first, last, shard->attempt);
+        }
+    }
+
+    SimulationResults results = collectRecords(records, config.games);
+    results.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    munmap(region, bytes);
+
+    return results;
+}
+
+} // namespace sharding
@@ -0,0 +1,22 @@
+#include <minefield/sharding.h>
+
+#include <minefield/tournament.h>
+
+namespace sharding
+{
+
+// No fork here: the shards run as threads of the in-process tournament instead
+
+bool isSupported()
+{
+    return false;
+}
+
+SimulationResults run(SimulationConfig const& config, Language& language, OutputSink&, ShardOptions const& options, ShardFaults const&)
+{
+    SimulationConfig inProcess = config;
+    inProcess.threads = options.processes;
+    return tournament::run(inProcess, language);
+}
+
+} // namespace sharding
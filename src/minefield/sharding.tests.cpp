@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <minefield/sharding.h>
+
+#include <cstdlib>
+
+namespace minefield::sharding::tests
+{
+
+class ShardingTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!::sharding::isSupported())
+        {
+            GTEST_SKIP() << "worker processes are only forked on Linux";
+        }
+
+        language.set(MessageId::PlayerCreation_kPCName, "PC");
+        config.games = 60;
+        config.players = 3;
+        config.seed = 21;
+        options.processes = 4;
+    }
+
+    Language language;
+    SimulationConfig config;
+    ShardOptions options;
+    ShardFaults faults;
+    NullSink output;
+};
+
+TEST_F(ShardingTestSuit, MatchesTheSequentialBatch)
+{
+    SimulationResults sequential = ::simulation::runBatch(config, language);
+    SimulationResults sharded = ::sharding::run(config, language, output, options);
+
+    EXPECT_EQ(sharded.games, config.games);
+    EXPECT_EQ(sharded.rounds, sequential.rounds);
+    EXPECT_EQ(sharded.outcomes, sequential.outcomes);
+}
+
+TEST_F(ShardingTestSuit, CrashedWorkerIsRetried)
+{
+    SimulationResults sequential = ::simulation::runBatch(config, language);
+
+    faults.beforeGame = [](unsigned int game, unsigned int attempt)
+    {
+        if (game == 20 && attempt == 0)
+        {
+            std::abort();
+        }
+    };
+
+    BufferSink log;
+    language.set(MessageId::Simulation_kShardRetry, "retry {} {} {}\n");
+    SimulationResults sharded = ::sharding::run(config, language, log, options, faults);
+
+    EXPECT_EQ(sharded.games, config.games);
+    EXPECT_EQ(sharded.outcomes, sequential.outcomes);
+    EXPECT_EQ(log.text(), "retry 1 15 29\n");
+}
+
+TEST_F(ShardingTestSuit, ShardIsGivenUpAfterTheLastAttempt)
+{
+    options.attempts = 2;
+    faults.beforeGame = [](unsigned int game, unsigned int)
+    {
+        if (game == 20)
+        {
+            std::abort();
+        }
+    };
+
+    SimulationResults sharded = ::sharding::run(config, language, output, options, faults);
+
+    // Games 15 to 19 finished before the crash, 20 to 29 never did
+
+    EXPECT_EQ(sharded.games, config.games - 10);
+}
+
+TEST_F(ShardingTestSuit, FailedForkIsRetried)
+{
+    SimulationResults sequential = ::simulation::runBatch(config, language);
+
+    faults.failFork = [](unsigned int shard, unsigned int attempt)
+    {
+        return shard == 2 && attempt == 0;
+    };
+
+    BufferSink log;
+    language.set(MessageId::Simulation_kShardRetry, "retry {} {} {}\n");
+    SimulationResults sharded = ::sharding::run(config, language, log, options, faults);
+
+    EXPECT_EQ(sharded.games, config.games);
+    EXPECT_EQ(sharded.outcomes, sequential.outcomes);
+    EXPECT_EQ(log.text(), "retry 2 30 44\n");
+}
+
+TEST_F(ShardingTestSuit, ShardThatCannotForkIsReported)
+{
+    options.attempts = 2;
+    faults.failFork = [](unsigned int shard, unsigned int)
+    {
+        return shard == 3;
+    };
+
+    BufferSink log;
+    language.set(MessageId::Simulation_kShardRetry, "retry {} {} {}\n");
+    language.set(MessageId::Simulation_kShardFailed, "failed {} {} {}\n");
+    SimulationResults sharded = ::sharding::run(config, language, log, options, faults);
+
+    EXPECT_EQ(sharded.games, config.games - 15);
+    EXPECT_EQ(log.text(), "retry 3 45 59\nfailed 45 59 2\n");
+}
+
+TEST_F(ShardingTestSuit, LockstepWorkers)
+{
+    SimulationResults sequential = ::simulation::runBatch(config, language);
+    config.lockstep = true;
+    SimulationResults sharded = ::sharding::run(config, language, output, options);
+
+    EXPECT_EQ(sharded.rounds, sequential.rounds);
+    EXPECT_EQ(sharded.outcomes, sequential.outcomes);
+}
+
+TEST_F(ShardingTestSuit, PresetWorkers)
+{
+    config.preset = BoardPreset::Large;
+    config.width.setValue(BoardConfig::Limits::kMaxdWidth);
+    config.height.setValue(BoardConfig::Limits::kMaxHeight);
+    config.mines.setValue(MineConfig::Limits::kMax);
+
+    SimulationResults sequential = ::simulation::runBatch(config, language);
+    SimulationResults sharded = ::sharding::run(config, language, output, options);
+
+    EXPECT_EQ(sharded.rounds, sequential.rounds);
+    EXPECT_EQ(sharded.outcomes, sequential.outcomes);
+}
+
+} // namespace minefield::sharding::tests
@@ -0,0 +1,392 @@
+#include <minefield/simulation.h>
+
+#include <minefield/fixed_board.h>
+#include <minefield/game_states.h>
+#include <minefield/lockstep.h>
+#include <minefield/sparse_board.h>
+#include <minefield/utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace simulation
+{
+
+bool isBatchRequest(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--batch")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseNumber(char const* text, unsigned int& value)
+{
+    char* end = nullptr;
+    unsigned long number = std::strtoul(text, &end, 10);
+
+    if (end == text || *end != '\0' || text[0] == '-' || number > UINT_MAX)
+    {
+        return false;
+    }
+
+    value = static_cast<unsigned int>(number);
+    return true;
+}
+
+template <typename PresetT>
+void applyPreset(unsigned int& width, unsigned int& height, unsigned int& mines)
+{
+    width = PresetT::BoardType::width;
+    height = PresetT::BoardType::height;
+    mines = PresetT::kInitialMines;
+}
+
+std::optional<SimulationConfig> parseArguments(int argc, char* argv[])
+{
+    SimulationConfig config;
+    unsigned int width = config.width.getValue();
+    unsigned int height = config.height.getValue();
+    unsigned int mines = config.mines.getValue();
+    bool sizeGiven = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view option(argv[i]);
+
+        if (option == "--batch")
+        {
+            continue;
+        }
+
+        if (option == "--lockstep")
+        {
+            config.lockstep = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            return std::nullopt;
+        }
+
+        char const* value = argv[++i];
+        bool parsed = false;
+
+        if (option == "--games")
+        {
+            parsed = parseNumber(value, config.games);
+        }
+        else if (option == "--width")
+        {
+            parsed = parseNumber(value, width);
+            sizeGiven = true;
+        }
+        else if (option == "--height")
+        {
+            parsed = parseNumber(value, height);
+            sizeGiven = true;
+        }
+        else if (option == "--mines")
+        {
+            parsed = parseNumber(value, mines);
+            sizeGiven = true;
+        }
+        else if (option == "--preset")
+        {
+            std::string_view name(value);
+            config.preset = (name == "small") ? BoardPreset::Small : (name == "large") ? BoardPreset::Large : BoardPreset::None;
+            parsed = config.preset != BoardPreset::None;
+        }
+        else if (option == "--players")
+        {
+            parsed = parseNumber(value, config.players);
+        }
+        else if (option == "--seed")
+        {
+            parsed = parseNumber(value, config.seed);
+        }
+        else if (option == "--threads")
+        {
+            parsed = parseNumber(value, config.threads);
+        }
+        else if (option == "--processes")
+        {
+            parsed = parseNumber(value, config.processes);
+        }
+        else if (option == "--rounds")
+        {
+            parsed = parseNumber(value, config.maxRounds);
+        }
+
+        if (!parsed)
+        {
+            return std::nullopt;
+        }
+    }
+
+    // A preset fixes the board size and the mines, and has no lockstep variant
+
+    if (config.preset != BoardPreset::None && (sizeGiven || config.lockstep))
+    {
+        return std::nullopt;
+    }
+
+    if (config.preset == BoardPreset::Small)
+    {
+        applyPreset<TournamentPresets::Small>(width, height, mines);
+    }
+    else if (config.preset == BoardPreset::Large)
+    {
+        applyPreset<TournamentPresets::Large>(width, height, mines);
+    }
+
+    // At least the board size the interactive setup asks for, and at least two players so no one is
+    // prompted. Fields a dense Board can't hold go to a SparseBoard, which needs a round limit and
+    // has no lockstep variant
+
+    bool sized = utils::isInRange<unsigned int>(width, BoardConfig::Limits::kMinWidth, BoardConfig::Limits::kMaxSparseWidth)
+        && utils::isInRange<unsigned int>(height, BoardConfig::Limits::kMinHeight, BoardConfig::Limits::kMaxSparseHeight);
+
+    bool dense = static_cast<long long>(width) * height <= BoardConfig::Limits::kMaxDenseCells;
+
+    bool valid = sized && (dense || (config.maxRounds > 0 && !config.lockstep))
+        && utils::isInRange<unsigned int>(mines, MineConfig::Limits::kMin, MineConfig::Limits::kMax)
+        && config.players >= 2 && config.games > 0;
+
+    if (!valid)
+    {
+        return std::nullopt;
+    }
+
+    config.width.setValue(width);
+    config.height.setValue(height);
+    config.mines.setValue(mines);
+
+    return config;
+}
+
+// Leaves the context as stateCreatingPlayers would, the board storage is reused between games.
+// The game index selects the generator stream, so a game plays the same whichever worker runs it
+
+template <typename BoardT>
+void setupGame(BasicGameContext<BoardT>& context, SimulationConfig const& config, unsigned int game)
+{
+    context.random.seed(config.seed, game);
+    context.width = config.width;
+    context.height = config.height;
+    utils::board::initialize(context.board, context.height, context.width);
+
+    context.round.setValue(1);
+    context.outcome = GameOutcome::None;
+    context.initialMines = config.mines;
+    context.mines = config.mines;
+
+    context.players.clear();
+
+    for (unsigned int i = 0; i < config.players; ++i)
+    {
+        std::string name = std::string(context.language[MessageId::PlayerCreation_kPCName]) + std::to_string(i + 1);
+        BasicPlayer<BoardT> player = utils::player::createPlayer<BoardT>(name, config.mines, PlayerCreation::Options::kPC);
+        player.id = i;
+        context.players.push_back(player);
+    }
+}
+
+bool needsSparseBoard(SimulationConfig const& config)
+{
+    return static_cast<long long>(config.width.getValue()) * config.height.getValue() > BoardConfig::Limits::kMaxDenseCells;
+}
+
+// Plays until the game ends, or until round maxRounds is over (then the outcome stays None)
+
+template <typename BoardT>
+GameOutcome playGame(BasicGameContext<BoardT>& context, unsigned int maxRounds)
+{
+    context.currentState = { &GameStates::statePuttingMines<BoardT> };
+
+    while (context.currentState.updateFunction != nullptr)
+    {
+        if (maxRounds > 0 && context.currentState.updateFunction == &GameStates::statePuttingMines<BoardT> && context.round.getValue() > maxRounds)
+        {
+            break;
+        }
+
+        context.currentState = (*context.currentState.updateFunction)(context);
+    }
+
+    return context.outcome;
+}
+
+template void setupGame(GameContext& context, SimulationConfig const& config, unsigned int game);
+template void setupGame(BasicGameContext<SparseBoard>& context, SimulationConfig const& config, unsigned int game);
+template GameOutcome playGame(GameContext& context, unsigned int maxRounds);
+template GameOutcome playGame(BasicGameContext<SparseBoard>& context, unsigned int maxRounds);
+template void setupGame(BasicGameContext<TournamentPresets::Small::BoardType>& context, SimulationConfig const& config, unsigned int game);
+template void setupGame(BasicGameContext<TournamentPresets::Large::BoardType>& context, SimulationConfig const& config, unsigned int game);
+template GameOutcome playGame(BasicGameContext<TournamentPresets::Small::BoardType>& context, unsigned int maxRounds);
+template GameOutcome playGame(BasicGameContext<TournamentPresets::Large::BoardType>& context, unsigned int maxRounds);
+
+template <typename BoardT>
+void playEachGame(BasicGameContext<BoardT>& context, SimulationConfig const& config, unsigned int firstGame, unsigned int games, GameHooks const& hooks)
+{
+    for (unsigned int game = firstGame; game < firstGame + games; ++game)
+    {
+        if (hooks.skip && hooks.skip(game))
+        {
+            continue;
+        }
+
+        setupGame(context, config, game);
+        GameOutcome outcome = playGame(context, config.maxRounds);
+        hooks.played(game, outcome, context.round.getValue());
+    }
+}
+
+// A batch of lanes is played unless every one of its games is skipped
+
+void playLockstep(SimulationConfig const& config, unsigned int firstGame, unsigned int games, GameHooks const& hooks)
+{
+    lockstep::GameBatch batch(config);
+    std::array<bool, lockstep::GameBatch::kLanes> skipped{};
+    unsigned int const end = firstGame + games;
+
+    for (unsigned int first = firstGame; first < end; first += lockstep::GameBatch::kLanes)
+    {
+        unsigned int lanes = std::min(lockstep::GameBatch::kLanes, end - first);
+        unsigned int playing = 0;
+
+        for (unsigned int lane = 0; lane < lanes; ++lane)
+        {
+            skipped[lane] = hooks.skip && hooks.skip(first + lane);
+            playing += !skipped[lane];
+        }
+
+        if (playing == 0)
+        {
+            continue;
+        }
+
+        batch.play(first, lanes);
+
+        for (unsigned int lane = 0; lane < lanes; ++lane)
+        {
+            if (!skipped[lane])
+            {
+                hooks.played(first + lane, batch.outcome(lane), batch.round(lane));
+            }
+        }
+    }
+}
+
+// The same games on another board, printing where context prints
+
+template <typename ContextT>
+void playEachGameOn(GameContext const& context, SimulationConfig const& config, unsigned int firstGame, unsigned int games, GameHooks const& hooks)
+{
+    ContextT boardContext;
+    boardContext.language = context.language;
+    boardContext.output = context.output;
+
+    playEachGame(boardContext, config, firstGame, games, hooks);
+}
+
+// Every batch runner (runBatch, tournament workers, process shards) plays its games through here,
+// so a config is played on the same engine and board whichever of them runs it
+
+void playGames(GameContext& context, SimulationConfig const& config, unsigned int firstGame, unsigned int games, GameHooks const& hooks)
+{
+    if (config.lockstep)
+    {
+        playLockstep(config, firstGame, games, hooks);
+        return;
+    }
+
+    if (needsSparseBoard(config))
+    {
+        playEachGameOn<BasicGameContext<SparseBoard>>(context, config, firstGame, games, hooks);
+        return;
+    }
+
+    if (config.preset == BoardPreset::Small)
+    {
+        playEachGameOn<TournamentPresets::Small>(context, config, firstGame, games, hooks);
+        return;
+    }
+
+    if (config.preset == BoardPreset::Large)
+    {
+        playEachGameOn<TournamentPresets::Large>(context, config, firstGame, games, hooks);
+        return;
+    }
+
+    playEachGame(context, config, firstGame, games, hooks);
+}
+
+void playGames(GameContext& context, SimulationConfig const& config, unsigned int firstGame, unsigned int games, SimulationResults& results)
+{
+    GameHooks hooks;
+    hooks.played = [&results](unsigned int, GameOutcome outcome, unsigned int round)
+    {
+        ++results.games;
+        results.rounds += round - 1;
+        ++results.outcomes[static_cast<std::size_t>(outcome)];
+    };
+
+    playGames(context, config, firstGame, games, hooks);
+}
+
+void mergeResults(SimulationResults& into, SimulationResults const& from)
+{
+    into.games += from.games;
+    into.rounds += from.rounds;
+
+    for (std::size_t i = 0; i < into.outcomes.size(); ++i)
+    {
+        into.outcomes[i] += from.outcomes[i];
+    }
+}
+
+SimulationResults runBatch(SimulationConfig const& config, Language const& language)
+{
+    SimulationResults results;
+
+    GameContext context;
+    context.language = language;
+    context.output = std::make_shared<NullSink>();
+
+    auto start = std::chrono::steady_clock::now();
+
+    playGames(context, config, 0, config.games, results);
+
+    results.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return results;
+}
+
+void printReport(Language& language, OutputSink& output, SimulationResults const& results)
+{
+    double gamesPerSecond = (results.seconds > 0.0) ? results.games / results.seconds : 0.0;
+    double roundsPerGame = (results.games > 0) ? static_cast<double>(results.rounds) / results.games : 0.0;
+
+    utils::printMessage(output, language, MessageId::Simulation_kHeader);
+    utils::printMessage(output, language, MessageId::Simulation_kGames, results.games);
+    utils::printMessage(output, language, MessageId::Simulation_kGamesPerSecond, gamesPerSecond);
+    utils::printMessage(output, language, MessageId::Simulation_kRoundsPerGame, roundsPerGame);
+    utils::printMessage(output, language, MessageId::Simulation_kOutcomeWinners, results.outcomes[static_cast<std::size_t>(GameOutcome::Winners)]);
+    utils::printMessage(output, language, MessageId::Simulation_kOutcomeElimination, results.outcomes[static_cast<std::size_t>(GameOutcome::Elimination)]);
+    utils::printMessage(output, language, MessageId::Simulation_kOutcomeNoPlayers, results.outcomes[static_cast<std::size_t>(GameOutcome::NoPlayersLeft)]);
+    utils::printMessage(output, language, MessageId::Simulation_kOutcomeBoardFull, results.outcomes[static_cast<std::size_t>(GameOutcome::BoardFull)]);
+    utils::printMessage(output, language, MessageId::Simulation_kOutcomeNoMines, results.outcomes[static_cast<std::size_t>(GameOutcome::NoAvailableMines)]);
+    utils::printMessage(output, language, MessageId::Simulation_kOutcomeUnfinished, results.outcomes[static_cast<std::size_t>(GameOutcome::None)]);
+}
+
+} // namespace simulation
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <minefield/simulation.h>
+
+#include <numeric>
+
+namespace minefield::simulation::tests
+{
+
+class SimulationTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        language.set(MessageId::PlayerCreation_kPCName, "PC");
+        config.games = 20;
+        config.players = 3;
+        config.seed = 7;
+    }
+
+    Language language;
+    SimulationConfig config;
+};
+
+TEST_F(SimulationTestSuit, EveryGameEndsWithAnOutcome)
+{
+    SimulationResults results = ::simulation::runBatch(config, language);
+
+    EXPECT_EQ(results.games, config.games);
+    EXPECT_EQ(results.outcomes[static_cast<std::size_t>(GameOutcome::None)], 0u);
+    EXPECT_EQ(std::accumulate(results.outcomes.begin(), results.outcomes.end(), 0u), config.games);
+    EXPECT_GT(results.rounds, 0u);
+}
+
+TEST_F(SimulationTestSuit, SameSeedGivesSameResults)
+{
+    SimulationResults first = ::simulation::runBatch(config, language);
+    SimulationResults second = ::simulation::runBatch(config, language);
+
+    EXPECT_EQ(first.rounds, second.rounds);
+    EXPECT_EQ(first.outcomes, second.outcomes);
+}
+
+TEST_F(SimulationTestSuit, ParseArguments)
+{
+    char const* valid[] = {"minefield", "--batch", "--games", "50", "--width", "30", "--mines", "4", "--seed", "9"};
+    auto parsed = ::simulation::parseArguments(10, const_cast<char**>(valid));
+
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->games, 50u);
+    EXPECT_EQ(parsed->width.getValue(), 30u);
+    EXPECT_EQ(parsed->height.getValue(), static_cast<unsigned int>(BoardConfig::Limits::kMinHeight));
+    EXPECT_EQ(parsed->mines.getValue(), 4u);
+    EXPECT_EQ(parsed->seed, 9u);
+    EXPECT_TRUE(::simulation::isBatchRequest(10, const_cast<char**>(valid)));
+
+    char const* outOfRange[] = {"minefield", "--batch", "--mines", "20"};
+    EXPECT_FALSE(::simulation::parseArguments(4, const_cast<char**>(outOfRange)).has_value());
+
+    char const* missingValue[] = {"minefield", "--batch", "--games"};
+    EXPECT_FALSE(::simulation::parseArguments(3, const_cast<char**>(missingValue)).has_value());
+
+    char const* onePlayer[] = {"minefield", "--batch", "--players", "1"};
+    EXPECT_FALSE(::simulation::parseArguments(4, const_cast<char**>(onePlayer)).has_value());
+}
+
+TEST_F(SimulationTestSuit, ParseArgumentsForSparseBoards)
+{
+    char const* sparse[] = {"minefield", "--batch", "--width", "100000", "--height", "100000", "--rounds", "10"};
+    auto parsed = ::simulation::parseArguments(8, const_cast<char**>(sparse));
+
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->maxRounds, 10u);
+    EXPECT_TRUE(::simulation::needsSparseBoard(*parsed));
+
+    // Past the Board limits but within kMaxDenseCells the field is still played on a Board
+    char const* wide[] = {"minefield", "--batch", "--width", "60", "--height", "60"};
+    auto dense = ::simulation::parseArguments(6, const_cast<char**>(wide));
+
+    ASSERT_TRUE(dense.has_value());
+    EXPECT_FALSE(::simulation::needsSparseBoard(*dense));
+
+    char const* noRoundLimit[] = {"minefield", "--batch", "--width", "100000"};
+    EXPECT_FALSE(::simulation::parseArguments(4, const_cast<char**>(noRoundLimit)).has_value());
+
+    char const* lockstep[] = {"minefield", "--batch", "--width", "100000", "--rounds", "10", "--lockstep"};
+    EXPECT_FALSE(::simulation::parseArguments(7, const_cast<char**>(lockstep)).has_value());
+
+    char const* tooWide[] = {"minefield", "--batch", "--width", "100001", "--rounds", "10"};
+    EXPECT_FALSE(::simulation::parseArguments(6, const_cast<char**>(tooWide)).has_value());
+}
+
+TEST_F(SimulationTestSuit, ParseArgumentsForPresets)
+{
+    char const* large[] = {"minefield", "--batch", "--preset", "large"};
+    auto parsed = ::simulation::parseArguments(4, const_cast<char**>(large));
+
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->preset, BoardPreset::Large);
+    EXPECT_EQ(parsed->width.getValue(), static_cast<unsigned int>(BoardConfig::Limits::kMaxdWidth));
+    EXPECT_EQ(parsed->height.getValue(), static_cast<unsigned int>(BoardConfig::Limits::kMaxHeight));
+    EXPECT_EQ(parsed->mines.getValue(), static_cast<unsigned int>(MineConfig::Limits::kMax));
+
+    // Without --preset the same size is played on a Board
+    char const* plain[] = {"minefield", "--batch"};
+    EXPECT_EQ(::simulation::parseArguments(2, const_cast<char**>(plain))->preset, BoardPreset::None);
+
+    char const* unknown[] = {"minefield", "--batch", "--preset", "medium"};
+    EXPECT_FALSE(::simulation::parseArguments(4, const_cast<char**>(unknown)).has_value());
+
+    char const* resized[] = {"minefield", "--batch", "--preset", "small", "--width", "30"};
+    EXPECT_FALSE(::simulation::parseArguments(6, const_cast<char**>(resized)).has_value());
+
+    char const* lockstep[] = {"minefield", "--batch", "--preset", "small", "--lockstep"};
+    EXPECT_FALSE(::simulation::parseArguments(5, const_cast<char**>(lockstep)).has_value());
+}
+
+TEST_F(SimulationTestSuit, PresetsMatchTheBoardBatch)
+{
+    SimulationResults board = ::simulation::runBatch(config, language);
+
+    config.preset = BoardPreset::Small;
+    SimulationResults preset = ::simulation::runBatch(config, language);
+
+    EXPECT_EQ(preset.games, board.games);
+    EXPECT_EQ(preset.rounds, board.rounds);
+    EXPECT_EQ(preset.outcomes, board.outcomes);
+}
+
+TEST_F(SimulationTestSuit, SparseBoardsStopAtTheRoundLimit)
+{
+    config.width.setValue(100000);
+    config.height.setValue(100000);
+    config.maxRounds = 5;
+
+    SimulationResults results = ::simulation::runBatch(config, language);
+
+    EXPECT_EQ(results.games, config.games);
+    EXPECT_EQ(results.rounds, 5ull * config.games);
+    EXPECT_EQ(results.outcomes[static_cast<std::size_t>(GameOutcome::None)], config.games);
+}
+
+} // namespace minefield::simulation::tests
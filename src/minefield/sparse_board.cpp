@@ -0,0 +1,181 @@
+#include <minefield/sparse_board.h>
+
+#include <algorithm>
+
+void SparseBoard::FreeCells::reset(std::uint64_t count)
+{
+    cellCount = count;
+    blocked.clear();
+}
+
+bool SparseBoard::FreeCells::empty() const
+{
+    return size() == 0;
+}
+
+std::uint64_t SparseBoard::FreeCells::size() const
+{
+    return cellCount - blocked.size();
+}
+
+// The free cell at slot is slot plus the blocked cells before it. blocked[i] - i counts the free
+// cells below blocked[i], which never decreases, so the blocked cells before it are the ones where
+// that count is still <= slot
+
+std::uint64_t SparseBoard::FreeCells::at(std::uint64_t slot) const
+{
+    std::uint64_t low = 0;
+    std::uint64_t high = blocked.size();
+
+    while (low < high)
+    {
+        std::uint64_t middle = low + (high - low) / 2;
+
+        if (blocked[middle] - middle <= slot)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return slot + low;
+}
+
+void SparseBoard::FreeCells::insert(std::uint64_t cellIndex)
+{
+    blocked.erase(std::lower_bound(blocked.begin(), blocked.end(), cellIndex));
+}
+
+void SparseBoard::FreeCells::remove(std::uint64_t cellIndex)
+{
+    blocked.insert(std::lower_bound(blocked.begin(), blocked.end(), cellIndex), cellIndex);
+}
+
+SparseBoard::Tile::Tile()
+{
+    states.fill(PositionState::Empty);
+    owners.fill(kNoOwner);
+    placementRounds.fill(0);
+}
+
+bool SparseBoard::empty() const
+{
+    return width == 0 || height == 0;
+}
+
+std::uint64_t SparseBoard::size() const
+{
+    return static_cast<std::uint64_t>(width) * height;
+}
+
+std::uint64_t SparseBoard::index(unsigned int x, unsigned int y) const
+{
+    return static_cast<std::uint64_t>(y) * width + x;
+}
+
+std::uint64_t SparseBoard::count(PositionState state) const
+{
+    return stateCounts[static_cast<std::size_t>(state)];
+}
+
+PositionState SparseBoard::state(unsigned int x, unsigned int y) const
+{
+    Tile const* tile = findTile(x, y);
+    return (tile != nullptr) ? tile->states[cellInTile(x, y)] : PositionState::Empty;
+}
+
+void SparseBoard::setState(unsigned int x, unsigned int y, PositionState state)
+{
+    PositionState& cell = touchTile(x, y).states[cellInTile(x, y)];
+
+    if (isFreeState(cell) != isFreeState(state))
+    {
+        if (isFreeState(state))
+        {
+            freeCells.insert(index(x, y));
+        }
+        else
+        {
+            freeCells.remove(index(x, y));
+        }
+    }
+
+    --stateCounts[static_cast<std::size_t>(cell)];
+    ++stateCounts[static_cast<std::size_t>(state)];
+    cell = state;
+}
+
+SparseBoard::Position SparseBoard::pack(MinePosition const& position) const
+{
+    return {index(position.x, position.y), position.state};
+}
+
+MinePosition SparseBoard::unpack(Position const& position) const
+{
+    return {static_cast<unsigned int>(position.index % width), static_cast<unsigned int>(position.index / width), position.state};
+}
+
+std::uint16_t SparseBoard::owner(unsigned int x, unsigned int y) const
+{
+    Tile const* tile = findTile(x, y);
+    return (tile != nullptr) ? tile->owners[cellInTile(x, y)] : kNoOwner;
+}
+
+std::uint16_t SparseBoard::placementRound(unsigned int x, unsigned int y) const
+{
+    Tile const* tile = findTile(x, y);
+    return (tile != nullptr) ? tile->placementRounds[cellInTile(x, y)] : 0;
+}
+
+void SparseBoard::placeMine(unsigned int x, unsigned int y, unsigned int ownerId, unsigned int round)
+{
+    setState(x, y, PositionState::WithMine);
+
+    Tile& tile = touchTile(x, y);
+    tile.owners[cellInTile(x, y)] = static_cast<std::uint16_t>(ownerId);
+    tile.placementRounds[cellInTile(x, y)] = static_cast<std::uint16_t>(round);
+}
+
+PositionState SparseBoard::operator[](std::uint64_t cellIndex) const
+{
+    return state(static_cast<unsigned int>(cellIndex % width), static_cast<unsigned int>(cellIndex / width));
+}
+
+std::uint64_t SparseBoard::tileKey(unsigned int x, unsigned int y)
+{
+    return (static_cast<std::uint64_t>(y / kTileSide) << 32) | (x / kTileSide);
+}
+
+unsigned int SparseBoard::cellInTile(unsigned int x, unsigned int y)
+{
+    return (y % kTileSide) * kTileSide + (x % kTileSide);
+}
+
+SparseBoard::Tile const* SparseBoard::findTile(unsigned int x, unsigned int y) const
+{
+    auto it = tiles.find(tileKey(x, y));
+    return (it != tiles.end()) ? &it->second : nullptr;
+}
+
+SparseBoard::Tile& SparseBoard::touchTile(unsigned int x, unsigned int y)
+{
+    return tiles[tileKey(x, y)];
+}
+
+namespace utils::board
+{
+
+void initialize(SparseBoard& board, Height height, Width width)
+{
+    board.width = width.getValue();
+    board.height = height.getValue();
+    board.tiles.clear();
+    board.stateCounts.fill(0);
+    board.stateCounts[static_cast<std::size_t>(PositionState::Empty)] = board.size();
+    board.freeCells.reset(board.size());
+}
+
+} // namespace utils::board
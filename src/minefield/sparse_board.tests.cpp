@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <minefield/game_states.h>
+#include <minefield/simulation.h>
+#include <minefield/sparse_board.h>
+#include <minefield/utils.h>
+
+#include <vector>
+
+namespace minefield::sparse_board::tests
+{
+
+// The same accessors have to behave the same way on the dense and the sparse board
+
+template <typename BoardT>
+class BoardAccessTestSuit : public ::testing::Test
+{
+protected:
+    BoardT board;
+};
+
+typedef ::testing::Types<Board, SparseBoard> BoardTypes;
+TYPED_TEST_SUITE(BoardAccessTestSuit, BoardTypes);
+
+TYPED_TEST(BoardAccessTestSuit, should_track_states_owners_and_counts)
+{
+    utils::board::initialize(this->board, Height{30}, Width{40});
+
+    EXPECT_FALSE(this->board.empty());
+    EXPECT_EQ(this->board.count(PositionState::Empty), 1200u);
+    EXPECT_EQ(this->board.state(39, 29), PositionState::Empty);
+    EXPECT_EQ(this->board.owner(39, 29), kNoOwner);
+
+    this->board.placeMine(39, 29, 3, 2);
+    this->board.setState(0, 0, PositionState::GuessedEmpty);
+    this->board.setState(39, 29, PositionState::GuessedMine);
+
+    EXPECT_EQ(this->board.state(39, 29), PositionState::GuessedMine);
+    EXPECT_EQ(this->board.owner(39, 29), 3u);
+    EXPECT_EQ(this->board.placementRound(39, 29), 2u);
+    EXPECT_EQ(this->board.count(PositionState::Empty), 1198u);
+    EXPECT_EQ(this->board.count(PositionState::GuessedMine), 1u);
+    EXPECT_EQ(this->board.count(PositionState::WithMine), 0u);
+}
+
+TEST(SparseBoard, should_only_allocate_touched_tiles_on_huge_boards)
+{
+    SparseBoard board;
+    utils::board::initialize(board, Height{100000}, Width{100000});
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        board.placeMine(i * 97, i * 89, i % 4, 1);
+    }
+
+    EXPECT_EQ(board.count(PositionState::WithMine), 1000u);
+    EXPECT_EQ(board.count(PositionState::Empty), 100000ull * 100000ull - 1000u);
+    EXPECT_LE(board.tiles.size(), 1000u);
+    EXPECT_EQ(board.state(97 * 5, 89 * 5), PositionState::WithMine);
+    EXPECT_EQ(board.state(99999, 99999), PositionState::Empty);
+    EXPECT_EQ(board.tiles.size(), 1000u);
+}
+
+TEST(SparseBoard, should_find_every_free_cell_by_its_slot)
+{
+    SparseBoard board;
+    utils::board::initialize(board, Height{24}, Width{24});
+
+    for (unsigned int y = 0; y < 24; ++y)
+    {
+        for (unsigned int x = 0; x < 24; ++x)
+        {
+            if ((x * 7 + y * 3) % 5 == 0)
+            {
+                board.setState(x, y, (x % 2) ? PositionState::Removed : PositionState::GuessedEmpty);
+            }
+        }
+    }
+
+    board.placeMine(1, 0, 0, 1);
+    board.setState(0, 0, PositionState::Empty);
+
+    std::vector<std::uint64_t> freeCells;
+
+    for (std::uint64_t cell = 0; cell < board.size(); ++cell)
+    {
+        if (isFreeState(board[cell]))
+        {
+            freeCells.push_back(cell);
+        }
+    }
+
+    ASSERT_EQ(board.freeCells.size(), freeCells.size());
+
+    for (std::size_t slot = 0; slot < freeCells.size(); ++slot)
+    {
+        EXPECT_EQ(board.freeCells.at(slot), freeCells[slot]);
+    }
+}
+
+// Games on a SparseBoard go through GameStates like the ones on a Board
+
+class SparseGameTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        config.players = 3;
+        config.seed = 5;
+        sparse.output = std::make_shared<NullSink>();
+        dense.output = std::make_shared<NullSink>();
+    }
+
+    SimulationConfig config;
+    BasicGameContext<SparseBoard> sparse;
+    GameContext dense;
+};
+
+TEST_F(SparseGameTestSuit, should_only_allocate_the_touched_tiles)
+{
+    config.width.setValue(100000);
+    config.height.setValue(100000);
+    config.players = 4;
+    config.maxRounds = 20;
+
+    ::simulation::setupGame(sparse, config, 0);
+
+    EXPECT_EQ(::simulation::playGame(sparse, config.maxRounds), GameOutcome::None);
+    EXPECT_EQ(sparse.round.getValue(), config.maxRounds + 1);
+
+    // Every round each player places and guesses at most its starting mines
+    std::size_t const touched = 2ull * config.players * config.mines.getValue() * config.maxRounds;
+    EXPECT_LE(sparse.board.tiles.size(), touched);
+}
+
+TEST_F(SparseGameTestSuit, should_replay_a_game_from_its_index)
+{
+    config.width.setValue(100000);
+    config.height.setValue(100000);
+    config.maxRounds = 20;
+
+    BasicGameContext<SparseBoard> other;
+    other.output = std::make_shared<NullSink>();
+
+    ::simulation::setupGame(sparse, config, 7);
+    ::simulation::playGame(sparse, config.maxRounds);
+
+    ::simulation::setupGame(other, config, 2);
+    ::simulation::playGame(other, config.maxRounds);
+    ::simulation::setupGame(other, config, 7);
+    ::simulation::playGame(other, config.maxRounds);
+
+    EXPECT_EQ(sparse.round.getValue(), other.round.getValue());
+    EXPECT_EQ(sparse.board.stateCounts, other.board.stateCounts);
+    ASSERT_EQ(sparse.players.size(), other.players.size());
+
+    for (std::size_t i = 0; i < sparse.players.size(); ++i)
+    {
+        EXPECT_EQ(sparse.players[i].remainingMines.getValue(), other.players[i].remainingMines.getValue());
+        EXPECT_EQ(sparse.players[i].opponentMinesDetected.getValue(), other.players[i].opponentMinesDetected.getValue());
+        EXPECT_EQ(sparse.players[i].ownMinesDetected.getValue(), other.players[i].ownMinesDetected.getValue());
+    }
+}
+
+// Until a cell leaves the free cells both boards list them in index order, so the first round
+// draws the same cells on both. When no mines collide it has to end the same way on both
+
+TEST_F(SparseGameTestSuit, should_play_the_first_round_like_a_board)
+{
+    unsigned int compared = 0;
+
+    for (unsigned int game = 0; game < 30; ++game)
+    {
+        ::simulation::setupGame(sparse, config, game);
+        ::simulation::setupGame(dense, config, game);
+
+        GameStates::statePuttingMines(sparse);
+        GameStates::stateProcessingMines(sparse);
+        GameStates::statePuttingMines(dense);
+        GameStates::stateProcessingMines(dense);
+
+        if (dense.board.count(PositionState::Removed) > 0)
+        {
+            continue;
+        }
+
+        GameStates::stateGuessingMines(sparse);
+        GameStates::stateProcessingGuesses(sparse);
+        GameStates::stateGuessingMines(dense);
+        GameStates::stateProcessingGuesses(dense);
+        ++compared;
+
+        for (std::size_t state = 0; state < kPositionStateCount; ++state)
+        {
+            EXPECT_EQ(sparse.board.stateCounts[state], dense.board.stateCounts[state]);
+        }
+
+        for (std::size_t i = 0; i < dense.players.size(); ++i)
+        {
+            Player const& expected = dense.players[i];
+            BasicPlayer<SparseBoard> const& player = sparse.players[i];
+
+            ASSERT_EQ(player.minesHistory.size(), expected.minesHistory.size());
+            ASSERT_EQ(player.guessesHistory.size(), expected.guessesHistory.size());
+
+            for (std::size_t mine = 0; mine < expected.minesHistory.size(); ++mine)
+            {
+                EXPECT_EQ(player.minesHistory[mine].index, expected.minesHistory[mine].index);
+            }
+
+            for (std::size_t guess = 0; guess < expected.guessesHistory.size(); ++guess)
+            {
+                EXPECT_EQ(player.guessesHistory[guess].index, expected.guessesHistory[guess].index);
+            }
+
+            EXPECT_EQ(player.remainingMines.getValue(), expected.remainingMines.getValue());
+            EXPECT_EQ(player.opponentMinesDetected.getValue(), expected.opponentMinesDetected.getValue());
+            EXPECT_EQ(player.ownMinesDetected.getValue(), expected.ownMinesDetected.getValue());
+        }
+    }
+
+    EXPECT_GT(compared, 20u);
+}
+
+// The free cells run out on a field this small, every game has to reach an outcome
+
+TEST_F(SparseGameTestSuit, should_play_a_small_field_to_the_end)
+{
+    for (unsigned int game = 0; game < 10; ++game)
+    {
+        ::simulation::setupGame(sparse, config, game);
+        EXPECT_NE(::simulation::playGame(sparse), GameOutcome::None);
+    }
+}
+
+} // namespace minefield::sparse_board::tests
@@ -0,0 +1,26 @@
+#include <minefield/terminal.h>
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace terminal
+{
+
+std::optional<TerminalSize> size()
+{
+    winsize window{};
+
+    if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &window) != 0 || window.ws_row == 0)
+    {
+        return std::nullopt;
+    }
+
+    return TerminalSize{window.ws_row, window.ws_col};
+}
+
+bool enableEscapes()
+{
+    return isatty(STDOUT_FILENO) != 0;
+}
+
+} // namespace terminal
@@ -0,0 +1,37 @@
+#include <minefield/terminal.h>
+
+#include <windows.h>
+
+namespace terminal
+{
+
+std::optional<TerminalSize> size()
+{
+    CONSOLE_SCREEN_BUFFER_INFO info{};
+
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info))
+    {
+        return std::nullopt;
+    }
+
+    unsigned int rows = static_cast<unsigned int>(info.srWindow.Bottom - info.srWindow.Top + 1);
+    unsigned int columns = static_cast<unsigned int>(info.srWindow.Right - info.srWindow.Left + 1);
+    return TerminalSize{rows, columns};
+}
+
+// Consoles before Windows 10 have no virtual terminal mode and ignore the escapes
+
+bool enableEscapes()
+{
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+
+    if (!GetConsoleMode(output, &mode))
+    {
+        return false;
+    }
+
+    return SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+}
+
+} // namespace terminal
@@ -0,0 +1,131 @@
+#include <minefield/thread_pool.h>
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (unsigned int i = 0; i < threads; ++i)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Tasks are dealt round-robin, stealing evens out whatever imbalance that leaves
+
+void ThreadPool::submit(Task task)
+{
+    std::size_t target;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        target = nextQueue;
+        nextQueue = (nextQueue + 1) % queues.size();
+        ++pending;
+        ++queued; // counted before the push so a worker never sees the task before the count
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+bool ThreadPool::popOwn(unsigned int worker, Task& task)
+{
+    WorkQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned int worker, Task& task)
+{
+    for (std::size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        WorkQueue& queue = *queues[(worker + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned int worker)
+{
+    while (true)
+    {
+        Task task;
+
+        if (popOwn(worker, task) || steal(worker, task))
+        {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                --queued;
+            }
+
+            task(worker);
+
+            bool finished;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                finished = (--pending == 0);
+            }
+            if (finished)
+            {
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+
+        if (stopping && queued == 0)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <minefield/tournament.h>
+
+#include <minefield/thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace tournament
+{
+
+// Cache line aligned so workers never write next to each other's counters
+
+struct alignas(64) WorkerSlot
+{
+    GameContext context;
+    SimulationResults results;
+};
+
+SimulationResults run(SimulationConfig const& config, Language const& language)
+{
+    ThreadPool pool(config.threads);
+
+    std::vector<WorkerSlot> slots(pool.size());
+
+    for (WorkerSlot& slot : slots)
+    {
+        slot.context.language = language;
+        slot.context.output = std::make_shared<NullSink>();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned int tasks = (config.games + kGamesPerTask - 1) / kGamesPerTask;
+
+    for (unsigned int task = 0; task < tasks; ++task)
+    {
+        unsigned int games = std::min(kGamesPerTask, config.games - task * kGamesPerTask);
+
+        pool.submit([&, task, games](unsigned int worker)
+        {
+            simulation::playGames(slots[worker].context, config, task * kGamesPerTask, games, slots[worker].results);
+        });
+    }
+
+    pool.wait();
+
+    SimulationResults results;
+    for (WorkerSlot const& slot : slots)
+    {
+        simulation::mergeResults(results, slot.results);
+    }
+
+    results.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return results;
+}
+
+} // namespace tournament
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <minefield/thread_pool.h>
+#include <minefield/tournament.h>
+
+#include <atomic>
+#include <numeric>
+
+namespace minefield::tournament::tests
+{
+
+TEST(ThreadPoolTestSuit, RunsEverySubmittedTask)
+{
+    ThreadPool pool(4);
+    std::atomic<unsigned int> total = 0;
+    std::vector<unsigned int> perWorker(pool.size());
+
+    for (unsigned int i = 1; i <= 1000; ++i)
+    {
+        pool.submit([&, i](unsigned int worker)
+        {
+            total += i;
+            ++perWorker[worker];
+        });
+    }
+    pool.wait();
+
+    EXPECT_EQ(total.load(), 500500u);
+    EXPECT_EQ(std::accumulate(perWorker.begin(), perWorker.end(), 0u), 1000u);
+}
+
+class TournamentTestSuit : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        language.set(MessageId::PlayerCreation_kPCName, "PC");
+        config.games = 3 * ::tournament::kGamesPerTask + 17;
+        config.players = 3;
+        config.seed = 11;
+    }
+
+    Language language;
+    SimulationConfig config;
+};
+
+TEST_F(TournamentTestSuit, ResultsDoNotDependOnThreadCount)
+{
+    config.threads = 1;
+    SimulationResults single = ::tournament::run(config, language);
+    config.threads = 4;
+    SimulationResults parallel = ::tournament::run(config, language);
+
+    EXPECT_EQ(single.games, config.games);
+    EXPECT_EQ(parallel.games, config.games);
+    EXPECT_EQ(single.rounds, parallel.rounds);
+    EXPECT_EQ(single.outcomes, parallel.outcomes);
+    EXPECT_EQ(std::accumulate(parallel.outcomes.begin(), parallel.outcomes.end(), 0u), config.games);
+}
+
+TEST_F(TournamentTestSuit, MatchesTheSequentialBatch)
+{
+    config.threads = 3;
+    SimulationResults sequential = ::simulation::runBatch(config, language);
+    SimulationResults parallel = ::tournament::run(config, language);
+
+    EXPECT_EQ(sequential.rounds, parallel.rounds);
+    EXPECT_EQ(sequential.outcomes, parallel.outcomes);
+}
+
+} // namespace minefield::tournament::tests
@@ -0,0 +1,377 @@
+#include <benchmark/benchmark.h>
+#include <minefield/constants.h>
+#include <minefield/fixed_board.h>
+#include <minefield/utils.h>
+
+#include <format>
+#include <iomanip>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace utils::bench
+{
+
+// Worst case for the end-of-round check: a maximum size board with no empty position left
+
+Board createFullBoard(bool withPlanes)
+{
+    Board board;
+    utils::board::initialize(board, Height(BoardConfig::Limits::kMaxHeight), Width(BoardConfig::Limits::kMaxdWidth));
+
+    for (unsigned int y = 0; y < board.height; ++y)
+    {
+        for (unsigned int x = 0; x < board.width; ++x)
+        {
+            board.setState(x, y, (x + y) % 3 == 0 ? PositionState::GuessedMine : PositionState::GuessedEmpty);
+        }
+    }
+
+    if (withPlanes)
+    {
+        utils::board::enablePlanes(board);
+    }
+
+    return board;
+}
+
+void hasEmptyPositions(benchmark::State& state)
+{
+    Board board = createFullBoard(state.range(0) != 0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::board::hasEmptyPositions(board));
+    }
+}
+BENCHMARK(hasEmptyPositions)->ArgName("planes")->Arg(0)->Arg(1);
+
+void countDetectedMines(benchmark::State& state)
+{
+    Board board = createFullBoard(state.range(0) != 0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::board::countState(board, PositionState::GuessedMine));
+    }
+}
+BENCHMARK(countDetectedMines)->ArgName("planes")->Arg(0)->Arg(1);
+
+void countEmptyInRow(benchmark::State& state)
+{
+    Board board = createFullBoard(state.range(0) != 0);
+
+    for (auto _ : state)
+    {
+        for (unsigned int y = 0; y < board.height; ++y)
+        {
+            benchmark::DoNotOptimize(utils::board::countEmptyInRow(board, y));
+        }
+    }
+}
+BENCHMARK(countEmptyInRow)->ArgName("planes")->Arg(0)->Arg(1);
+
+// Same scans on the tournament preset, whose dimensions are known at compile time
+
+void countDetectedMinesFixed(benchmark::State& state)
+{
+    TournamentPresets::Large::BoardType board;
+    utils::board::initialize(board);
+
+    for (unsigned int y = 0; y < board.height; ++y)
+    {
+        for (unsigned int x = 0; x < board.width; ++x)
+        {
+            board.setState(x, y, (x + y) % 3 == 0 ? PositionState::GuessedMine : PositionState::GuessedEmpty);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::board::hasEmptyPositions(board));
+        benchmark::DoNotOptimize(utils::board::countState(board, PositionState::GuessedMine));
+    }
+}
+BENCHMARK(countDetectedMinesFixed);
+
+void countDetectedMinesRuntime(benchmark::State& state)
+{
+    Board board = createFullBoard(false);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::board::hasEmptyPositions(board));
+        benchmark::DoNotOptimize(utils::board::countState(board, PositionState::GuessedMine));
+    }
+}
+BENCHMARK(countDetectedMinesRuntime);
+
+// Many players dropping mines on a maximum size board, so most rounds have collisions
+
+Players createCrowdedPlayers(Board const& board, unsigned int playerCount, unsigned int minesPerPlayer)
+{
+    std::mt19937 generator(playerCount);
+    std::uniform_int_distribution<unsigned int> xDistribution(0, board.width - 1);
+    std::uniform_int_distribution<unsigned int> yDistribution(0, board.height - 1);
+
+    Players players(playerCount);
+
+    for (auto& player : players)
+    {
+        for (unsigned int i = 0; i < minesPerPlayer; ++i)
+        {
+            player.placedMines.push_back(board.pack({xDistribution(generator), yDistribution(generator), PositionState::WithMine}));
+        }
+    }
+
+    return players;
+}
+
+// The red-black tree detection stateProcessingMines used before findCollisions
+
+std::vector<MinePosition> findCollisionsWithSets(Board const& board, Players const& players)
+{
+    std::set<MinePosition> mineSet;
+    std::set<MinePosition> duplicateMinesSet;
+
+    for (auto const& player : players)
+    {
+        for (auto const& packedMine : player.placedMines)
+        {
+            MinePosition mine = board.unpack(packedMine);
+
+            if (!mineSet.insert(mine).second)
+            {
+                duplicateMinesSet.insert(mine);
+            }
+        }
+    }
+
+    std::vector<MinePosition> collisions;
+
+    for (auto const& player : players)
+    {
+        for (auto const& packedMine : player.placedMines)
+        {
+            MinePosition mine = board.unpack(packedMine);
+
+            if (duplicateMinesSet.erase(mine) > 0)
+            {
+                collisions.push_back(mine);
+            }
+        }
+    }
+
+    return collisions;
+}
+
+void collisionsWithSets(benchmark::State& state)
+{
+    Board board;
+    utils::board::initialize(board, Height(BoardConfig::Limits::kMaxHeight), Width(BoardConfig::Limits::kMaxdWidth));
+    Players players = createCrowdedPlayers(board, static_cast<unsigned int>(state.range(0)), MineConfig::Limits::kMax);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findCollisionsWithSets(board, players));
+    }
+}
+BENCHMARK(collisionsWithSets)->ArgName("players")->Arg(100)->Arg(500)->Arg(1000);
+
+void collisionsWithCounts(benchmark::State& state)
+{
+    Board board;
+    utils::board::initialize(board, Height(BoardConfig::Limits::kMaxHeight), Width(BoardConfig::Limits::kMaxdWidth));
+    Players players = createCrowdedPlayers(board, static_cast<unsigned int>(state.range(0)), MineConfig::Limits::kMax);
+    std::vector<unsigned int> placementCounts;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::game::findCollisions(board, players, placementCounts));
+    }
+}
+BENCHMARK(collisionsWithCounts)->ArgName("players")->Arg(100)->Arg(500)->Arg(1000);
+
+// Drawing a PC mine position: the old global rand() % max against the per-context generator
+
+void randomPositionWithRand(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        unsigned int x = rand() % BoardConfig::Limits::kMaxdWidth;
+        unsigned int y = rand() % BoardConfig::Limits::kMaxHeight;
+        benchmark::DoNotOptimize(x + y);
+    }
+}
+BENCHMARK(randomPositionWithRand);
+
+void randomPositionWithPcg(benchmark::State& state)
+{
+    Pcg32 random(1);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::board::getRandomBoardPosition(random, Width(BoardConfig::Limits::kMaxdWidth), Height(BoardConfig::Limits::kMaxHeight)));
+    }
+}
+BENCHMARK(randomPositionWithPcg);
+
+// PC pick on a board with a single free cell left: retrying whole-board draws against the free-cell pool
+
+Board createBoardWithOneFreeCell()
+{
+    Board board = createFullBoard(false);
+    board.setState(board.width / 2, board.height / 2, PositionState::Empty);
+    return board;
+}
+
+void freePositionByRetrying(benchmark::State& state)
+{
+    Board board = createBoardWithOneFreeCell();
+    Pcg32 random(1);
+
+    for (auto _ : state)
+    {
+        MinePosition pick = utils::board::getRandomBoardPosition(random, Width(unsigned{board.width}), Height(unsigned{board.height}));
+        while (!isFreeState(board.state(pick.x, pick.y)))
+        {
+            pick = utils::board::getRandomBoardPosition(random, Width(unsigned{board.width}), Height(unsigned{board.height}));
+        }
+        benchmark::DoNotOptimize(pick);
+    }
+}
+BENCHMARK(freePositionByRetrying);
+
+void freePositionFromPool(benchmark::State& state)
+{
+    Board board = createBoardWithOneFreeCell();
+    Pcg32 random(1);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::board::getRandomFreePosition(random, board));
+    }
+}
+BENCHMARK(freePositionFromPool);
+
+// One board view per frame on a maximum size board: the per-cell std::setw stream printPerPlayer
+// used before against the glyph renderer on a reused buffer
+
+Player createPlayerWithHistory(Board const& board)
+{
+    Player player;
+    player.guessedCells.reserveCells(board.size());
+    player.ownMineCells.reserveCells(board.size());
+
+    for (std::size_t cell = 0; cell < board.size(); cell += 7)
+    {
+        player.guessedCells.set(cell);
+        player.ownMineCells.set(cell + 3 < board.size() ? cell + 3 : cell);
+    }
+
+    return player;
+}
+
+std::string formatPerPlayerWithStream(Board const& board, Player const& player)
+{
+    std::ostringstream frame;
+    frame << std::setw(Display::kBoardColWidth) << "";
+
+    for (unsigned int x = 0; x < board.width; ++x)
+    {
+        frame << std::setw(Display::kBoardColWidth) << x;
+    }
+
+    frame << '\n';
+
+    for (unsigned int y = 0; y < board.height; ++y)
+    {
+        frame << std::setw(Display::kBoardColWidth) << y;
+
+        for (std::size_t cell = board.index(0, y); cell < board.index(0, y + 1); ++cell)
+        {
+            PositionState cellState = board[cell];
+
+            if (player.guessedCells.test(cell) || cellState == PositionState::Removed)
+            {
+                frame << std::setw(Display::kBoardColWidth) << utils::board::getStateValue(cellState);
+            }
+            else
+            {
+                frame << std::setw(Display::kBoardColWidth) << (player.ownMineCells.test(cell) ? 1 : 0);
+            }
+        }
+
+        frame << '\n';
+    }
+
+    return frame.str();
+}
+
+void frameWithStream(benchmark::State& state)
+{
+    Board board = createFullBoard(false);
+    Player player = createPlayerWithHistory(board);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatPerPlayerWithStream(board, player));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(frameWithStream);
+
+void frameWithGlyphs(benchmark::State& state)
+{
+    Board board = createFullBoard(false);
+    Player player = createPlayerWithHistory(board);
+    std::string frame;
+
+    for (auto _ : state)
+    {
+        utils::board::renderPerPlayer(frame, board, player.guessedCells, player.ownMineCells);
+        benchmark::DoNotOptimize(frame.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(frameWithGlyphs);
+
+// A round's score line, formatted the way printMessage used to and with the parsed template
+
+std::string const kScoreLine = "{}: {} opponent mines found, {} of its own\n";
+
+void messageWithVformat(benchmark::State& state)
+{
+    std::string name = "Player 1";
+    unsigned int opponent = 12;
+    unsigned int own = 3;
+
+    for (auto _ : state)
+    {
+        std::string text = std::vformat(kScoreLine, std::make_format_args(name, opponent, own));
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(messageWithVformat);
+
+void messageWithTemplate(benchmark::State& state)
+{
+    MessageTemplate message(kScoreLine);
+    std::string name = "Player 1";
+    unsigned int opponent = 12;
+    unsigned int own = 3;
+    std::string text;
+
+    for (auto _ : state)
+    {
+        text.clear();
+        message.formatTo(text, name, opponent, own);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(messageWithTemplate);
+
+} // namespace utils::bench
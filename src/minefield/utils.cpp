@@ -1,141 +1,40 @@
 #include <minefield/utils.h>
 
+#include <minefield/delta_renderer.h>
+#include <minefield/terminal.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
 #include <cstdio>
-#include <iomanip>
-#include <iostream>
 #include <format>
 #include <set>
+#include <stdexcept>
 
 namespace utils
 {
 
-unsigned int getRandomNumberInRange(int max)
+unsigned int getRandomNumberInRange(Pcg32& random, int max)
 {
-    unsigned int number = rand() % max;
+    unsigned int number = random.bounded(static_cast<unsigned int>(max));
     return number;
 }
 
-namespace game
-{
-
-void enterMine(GameContext& context, Player& player)
-{
-    if (context.board.empty())
-    {
-        std::cout << context.language["utilsMsg::kEmptyBoard"];
-    }
-
-    for (unsigned int i = 0; i < context.mines.getValue(); i++)
-    {
-        unsigned int iPlus1 = i + 1;
-        std::cout << std::vformat(context.language["PuttingMines::kMessage"], std::make_format_args(iPlus1, context.mines.getValue()));
-
-        MinePosition minePosition = utils::board::validBoardPositionState(context.language, context.width, context.height, player);
-        context.board[minePosition.x][minePosition.y] = minePosition;
-
-        std::cout << std::vformat(context.language["PuttingMines::kSuccessMessage"], std::make_format_args(player.name, minePosition.x, minePosition.y));
-
-        player.placedMines.push_back(minePosition);
-    }
-
-    utils::player::saveMines(player);
-}
-
-bool hasOnePlayer(Language& language, Players const& players)
-{
-    if (players.size() > 1)
-    {
-        return false;
-    }
-
-    std::cout << language["Results::kHeaderGameOver"];
-
-    if (players.size() == 1)
-    {
-        std::cout << std::vformat(language["Results::kWinnerByElimination"], std::make_format_args(players[0].name));
-    }
-    else
-    {
-        std::cout << language["Results::kNoPlayersRemainingTie"];
-    }
-
-    return true;
-}
-
-void handleOwnMine(Language& language, Player& player, MinePosition const& mine, Board& board)
-{
-    if (board.empty())
-    {
-        std::cout << language["utilsMsg::kEmptyBoard"];
-    }
-
-    std::cout << std::vformat(language["ProcessingGuesses::kHitOwnMine"], std::make_format_args(player.name, mine.x, mine.y));
-    player.ownMinesDetected.setValue(player.ownMinesDetected.getValue() + 1);
-
-    if (player.remainingMines.getValue() > 0)
-    {
-        std::cout << std::vformat(language["ProcessingGuesses::kMinesRemaining"], std::make_format_args(player.remainingMines.getValue()));
-        player.remainingMines.setValue(player.remainingMines.getValue() - 1);
-        board[mine.x][mine.y].state = PositionState::Removed;
-    }
-}
-
-void handleOpponentMine(Language& language, Player& player, MinePosition const& mine, Board& board, Players const& players)
-{
-    if (board.empty())
-    {
-        std::cout << language["utilsMsg::kEmptyBoard"];
-    }
-
-    if (players.empty())
-    {
-        std::cout << language["utilsMsg::kEmptyPlayers"];
-    }
-
-    // If the position has a mine, the player detected a mine from other player
-
-    std::cout << std::vformat(language["ProcessingGuesses::kHitOpponentMine"], std::make_format_args(player.name, mine.x, mine.y));
-    player.opponentMinesDetected.setValue(player.opponentMinesDetected.getValue() + 1);
-    board[mine.x][mine.y].state = PositionState::GuessedMine;
-
-    for (auto const& opponent : players)
-    {
-        if (opponent.name != player.name && utils::player::isMineFromPlayer(mine, opponent.placedMines))
-        {
-            std::cout << std::vformat(language["ProcessingGuesses::kItWasPlayersMine"], std::make_format_args(opponent.name));
-            break;
-        }
-    }
-}
-
-void handleMiss(Language& language, Player const& player, MinePosition const& mine, Board& board)
-{
-    if (board.empty())
-    {
-        std::cout << language["utilsMsg::kEmptyBoard"];
-    }
-
-    std::cout << std::vformat(language["ProcessingGuesses::kMiss"], std::make_format_args(player.name, mine.x, mine.y));
-    board[mine.x][mine.y].state = PositionState::GuessedEmpty;
-}
-
-} // namespace game
-
 namespace player
 {
 
 Player getPCPlayer(Language& language, MinesCount initialMines)
 {
     char type = PlayerCreation::Options::kPC;
-    std::string PCName = language["PlayerCreation::kPCName"];
+    std::string PCName(language[MessageId::PlayerCreation_kPCName]);
     Player player = utils::player::createPlayer(PCName, initialMines, type);
     return player;
 }
 
-void addPlayers(Language& language, Players& players, MinesCount initialMines)
+Task<void> addPlayers(Language& language, OutputSink& output, GameInput& input, Players& players, MinesCount initialMines)
 {
-    std::string message = std::vformat(language["PlayerCreation::kNamePrompt"], std::make_format_args(PlayerCreation::Options::kStopCreation));
-    auto name = utils::enterValue<std::string>(message);
+    std::string message = language.message(MessageId::PlayerCreation_kNamePrompt).format(PlayerCreation::Options::kStopCreation);
+    auto name = co_await utils::enterValue<std::string>(output, input, message);
 
     // PlayerCreation::Options::kStopCreation is a char '*'
     // It's casted to std::string to be compared with name (std::string)
@@ -146,23 +45,30 @@ void addPlayers(Language& language, Players& players, MinesCount initialMines)
     {
         if (utils::player::nameExists(name, players))
         {
-            std::cout << std::vformat(language["PlayerCreation::kRepeatedName"], std::make_format_args(name));
+            utils::printMessage(output, language, MessageId::PlayerCreation_kRepeatedName, name);
         }
         else
         {
-            char type = utils::player::getType(language, name);
+            char type = co_await utils::player::getType(language, output, input, name);
 
             Player newPlayer = createPlayer(name, initialMines, type);
+            newPlayer.id = static_cast<unsigned int>(players.size());
 
             players.push_back(newPlayer);
 
-            std::cout << std::vformat(language["PlayerCreation::kAdded"], std::make_format_args(name));
+            utils::printMessage(output, language, MessageId::PlayerCreation_kAdded, name);
         }
 
-        name = utils::enterValue<std::string>(message);
+        name = co_await utils::enterValue<std::string>(output, input, message);
     }
 }
 
+void addPlayers(Language& language, OutputSink& output, Players& players, MinesCount initialMines)
+{
+    GameInput console(std::cin);
+    runBlocking(addPlayers(language, output, console, players, initialMines));
+}
+
 bool nameExists(std::string const& name, std::vector<Player> const& players)
 {
     for (auto const& player : players)
@@ -180,278 +86,195 @@ bool isTypeValid(char type)
     return (type == PlayerCreation::Options::kHuman || type == PlayerCreation::Options::kPC);
 }
 
-char getType(Language& language, std::string const& name)
+Task<char> getType(Language& language, OutputSink& output, GameInput& input, std::string name)
 {
-    std::string message = std::vformat(language["PlayerCreation::kTypePrompt"], std::make_format_args(name, PlayerCreation::Options::kHuman, PlayerCreation::Options::kPC));
-    auto type = utils::enterValue<char>(message);
+    std::string message = language.message(MessageId::PlayerCreation_kTypePrompt).format(name, PlayerCreation::Options::kHuman, PlayerCreation::Options::kPC);
+    auto type = co_await utils::enterValue<char>(output, input, message);
 
     while (!isTypeValid(type))
     {
-        message = std::vformat(language["PlayerCreation::kInvalidType"], std::make_format_args(PlayerCreation::Options::kHuman, PlayerCreation::Options::kPC));
-        type = utils::enterValue<char>(message);
+        message = language.message(MessageId::PlayerCreation_kInvalidType).format(PlayerCreation::Options::kHuman, PlayerCreation::Options::kPC);
+        type = co_await utils::enterValue<char>(output, input, message);
     }
 
-    return type;
+    co_return type;
 }
 
-Player createPlayer(std::string const& name, MinesCount initialMines, char type)
+char getType(Language& language, OutputSink& output, std::string const& name)
 {
-    Player player;
-
-    player.name = name;
-    player.remainingMines = initialMines;
-    player.remainingGuesses.setValue(initialMines.getValue());
-    player.enterMine = &utils::game::enterMine;
-    player.type = (type == PlayerCreation::Options::kHuman) ? PlayerType::HumanPlayer : PlayerType::PC;
-
-    return player;
+    GameInput console(std::cin);
+    return runBlocking(getType(language, output, console, name));
 }
 
-void saveMines(Player& player)
+bool isMineFromPlayer(MinePosition const& guess, std::vector<MinePosition> const& minePositions)
 {
-    for (auto const& mine : player.placedMines)
+    for (auto const& minePosition : minePositions)
     {
-        player.minesHistory.push_back(mine);
+        if (minePosition == guess)
+        {
+            return true;
+        }
     }
+    return false;
 }
 
-void saveGuesses(Player& player)
+} // namespace players
+
+namespace board
 {
-    for (auto const& mine : player.placedGuesses)
-    {
-        player.guessesHistory.push_back(mine);
-    }
-}
 
-Player const* getTopScorer(Language& language, Players const& players)
+int getStateValue(PositionState state)
 {
-    Player const* topPlayer = nullptr;
+    return static_cast<int>(state);
+}
 
-    unsigned int maxScore = 0;
+// Popcount of the bits [begin, end) of a plane
 
-    for (auto const& player : players)
+unsigned int countPlaneBits(std::vector<std::uint64_t> const& words, std::size_t begin, std::size_t end)
+{
+    if (begin >= end)
     {
-        unsigned int score = player.opponentMinesDetected.getValue() - player.ownMinesDetected.getValue();
-
-        std::cout << std::vformat(language["Results::kScoreOfPlayer"], std::make_format_args(player.name, score));
-
-        if (score > maxScore)
-        {
-            maxScore = score;
-            topPlayer = &player;
-        }
+        return 0;
     }
 
-    return topPlayer;
-}
+    std::size_t const kBits = BoardPlanes::kBitsPerWord;
+    std::size_t firstWord = begin / kBits;
+    std::size_t lastWord = (end - 1) / kBits;
+    std::uint64_t firstMask = ~std::uint64_t{0} << (begin % kBits);
+    std::uint64_t lastMask = ~std::uint64_t{0} >> (kBits - 1 - (end - 1) % kBits);
 
-bool areThereWinners(Language& language, Players const& winners)
-{
-    if (winners.empty())
+    if (firstWord == lastWord)
     {
-        return false;
+        return std::popcount(words[firstWord] & firstMask & lastMask);
     }
 
-    std::cout << language["Results::kHeaderGameOverWinner"];
+    unsigned int count = std::popcount(words[firstWord] & firstMask);
 
-    if (winners.size() == 1)
-    {
-        std::cout << std::vformat(language["Results::kWinnerWins"], std::make_format_args(winners[0].name));
-        std::cout << language["Results::kCongratulations"];
-    }
-    else
+    for (std::size_t i = firstWord + 1; i < lastWord; ++i)
     {
-        std::cout << language["Results::kTie"];
-        std::cout << language["Results::kWinnersListHeader"];
-        for (auto const& winner : winners)
-        {
-            std::cout << std::vformat(language["Results::kWinnerListItem"], std::make_format_args(winner.name));
-        }
+        count += std::popcount(words[i]);
     }
 
-    return true;
+    return count + std::popcount(words[lastWord] & lastMask);
 }
 
-Players getRemainigPlayers(Players const& players, Players const& removed)
+bool hasEmptyPositions(Board const& board)
 {
-    Players result;
-
-    for (auto const& player : players)
+    if (board.planes.enabled())
     {
-        if (std::find(removed.begin(), removed.end(), player) == removed.end())
-        {
-            result.push_back(player);
-        }
+        std::vector<std::uint64_t> const& empty = board.planes.plane(PositionState::Empty);
+        return std::any_of(empty.begin(), empty.end(), [](std::uint64_t word) { return word != 0; });
     }
 
-    return result;
+    return std::find(board.cells.begin(), board.cells.end(), PositionState::Empty) != board.cells.end();
 }
 
-int countOpponentMines(Player const& player, Players const& players)
+void enablePlanes(Board& board)
 {
-    int totalOpponentMines = 0;
+    std::size_t words = (board.size() + BoardPlanes::kBitsPerWord - 1) / BoardPlanes::kBitsPerWord;
 
-    for (auto const& other : players)
+    // An empty board keeps the planes disabled, there is nothing to mirror
+
+    for (auto& plane : board.planes.bits)
     {
-        if (other.name != player.name)
-        {
-            totalOpponentMines += other.placedMines.size();
-        }
+        plane.assign(words, 0);
     }
 
-    return totalOpponentMines;
+    for (std::size_t i = 0; i < board.size(); ++i)
+    {
+        board.planes.set(i, board[i]);
+    }
 }
 
-bool isMineFromPlayer(MinePosition const& guess, std::vector<MinePosition> const& minePositions)
+unsigned int countState(Board const& board, PositionState state)
 {
-    for (auto const& minePosition : minePositions)
+    if (board.planes.enabled())
     {
-        if (minePosition == guess)
-        {
-            return true;
-        }
+        return countPlaneBits(board.planes.plane(state), 0, board.size());
     }
-    return false;
+
+    return static_cast<unsigned int>(std::count(board.cells.begin(), board.cells.end(), state));
 }
 
-GuessesCount whoHasLessAvailableMines(Players const& players)
+void enableRangeIndex(Board& board)
 {
-    GuessesCount lessGuesses{std::numeric_limits<unsigned int>::max()};
-    for (auto const& player : players)
+    BoardRangeIndex& rangeIndex = board.rangeIndex;
+    rangeIndex.width = board.width;
+    rangeIndex.height = board.height;
+
+    for (std::size_t state = 0; state < kPositionStateCount; ++state)
     {
-        if (player.remainingMines.getValue() < lessGuesses.getValue())
+        std::vector<unsigned int>& tree = rangeIndex.trees[state];
+        tree.assign(board.size(), 0);
+
+        for (std::size_t i = 0; i < board.size(); ++i)
         {
-            lessGuesses.setValue(player.remainingMines.getValue());
+            tree[i] = (static_cast<std::size_t>(board[i]) == state) ? 1 : 0;
         }
-    }
-    return lessGuesses;
-}
-
-} // namespace players
 
-namespace board
-{
+        // Linear Fenwick build, one dimension at a time: every node adds itself to its parent
 
-int getStateValue(PositionState state)
-{
-    return static_cast<int>(state);
-}
+        for (unsigned int y = 0; y < board.height; ++y)
+        {
+            for (unsigned int i = 1; i <= board.width; ++i)
+            {
+                unsigned int parent = i + (i & (~i + 1));
+                if (parent <= board.width)
+                {
+                    tree[board.index(parent - 1, y)] += tree[board.index(i - 1, y)];
+                }
+            }
+        }
 
-bool hasEmptyPositions(Width width, Height height, Board const& board)
-{
-    for (unsigned int i = 0; i < width.getValue(); ++i)
-    {
-        for (unsigned int j = 0; j < height.getValue(); ++j)
+        for (unsigned int x = 0; x < board.width; ++x)
         {
-            if (board[i][j].state == PositionState::Empty)
+            for (unsigned int j = 1; j <= board.height; ++j)
             {
-                return true;
+                unsigned int parent = j + (j & (~j + 1));
+                if (parent <= board.height)
+                {
+                    tree[board.index(x, parent - 1)] += tree[board.index(x, j - 1)];
+                }
             }
         }
     }
-
-    return false;
 }
 
-bool isFull(Language& language, Width width, Height height, Board const& board, Players const& players)
-{
-    if (utils::board::hasEmptyPositions(width, height, board))
-    {
-        return false;
-    }
-
-    // If the game ended because of the board being full,
-    // the winner is determined by the number of mines it guessed
-
-    std::cout << language["Results::kHeaderGameOverBoardFull"];
-    std::cout << language["Results::kNoMorePositions"];
-    std::cout << language["Results::kFinalScores"];
+// Cells in state inside the rectangle with corners from and to (from.x <= to.x, from.y <= to.y), both included
 
-    Player const* topPlayer = utils::player::getTopScorer(language, players);
-
-    if (topPlayer != nullptr)
-    {
-        std::cout << std::vformat(language["Results::kWinnerByPoints"], std::make_format_args(topPlayer->name));
-    }
-
-    return true;
-} 
-
-/*
-    How the board would look like:
-
-    0  1  2  3 ...
-    0  0  0  0  0 ...
-    1  1  1  0  0 ...
-    2  0  0  0  0 ...
-    3  0  0  0  0 ...
-    .. .. .. .. .. ...
-*/
-
-void printPerPlayer(Width width, Height height, Board const& board, Player const& player)
+unsigned int countStateInArea(Board const& board, PositionState state, MinePosition const& from, MinePosition const& to)
 {
-    std::cout << std::setw(Display::kBoardColWidth) << "";
-
-    for (unsigned int i = 0; i < width.getValue(); ++i)
+    if (board.rangeIndex.enabled())
     {
-        std::cout << std::setw(Display::kBoardColWidth) << i;
+        BoardRangeIndex const& rangeIndex = board.rangeIndex;
+        return rangeIndex.prefix(state, to.x + 1, to.y + 1) - rangeIndex.prefix(state, from.x, to.y + 1) - rangeIndex.prefix(state, to.x + 1, from.y)
+            + rangeIndex.prefix(state, from.x, from.y);
     }
 
-    std::cout << '\n';
+    unsigned int count = 0;
 
-    for (unsigned int j = 0; j < height.getValue(); ++j)
+    for (unsigned int y = from.y; y <= to.y; ++y)
     {
-        std::cout << std::setw(Display::kBoardColWidth) << j;
-
-        for (unsigned int k = 0; k < width.getValue(); ++k)
+        for (unsigned int x = from.x; x <= to.x; ++x)
         {
-            MinePosition minePositionFromBoard = board[j][k];
-
-            // If the player has guessed this position (empty, mine, or own mine), show its actual state value.
-            // If the player has placed a mine here but hasn't guessed it, show '1'.
-            // Otherwise, show '0'.
-
-            if (utils::player::isMineFromPlayer(minePositionFromBoard, player.guessesHistory) || minePositionFromBoard.state == PositionState::Removed)
-            {
-                std::cout << std::setw(Display::kBoardColWidth) << getStateValue(minePositionFromBoard.state);
-            }
-            else if (utils::player::isMineFromPlayer(minePositionFromBoard, player.minesHistory))
-            {
-                std::cout << std::setw(Display::kBoardColWidth) << 1;
-            }
-            else
-            {
-                std::cout << std::setw(Display::kBoardColWidth) << 0;
-            }
+            count += (board.state(x, y) == state) ? 1 : 0;
         }
-
-        std::cout << '\n';
     }
-}
 
-MinePosition getRandomBoardPosition(Width width, Height height)
-{
-    unsigned int xPos = getRandomNumberInRange(width.getValue());
-    unsigned int yPos = getRandomNumberInRange(height.getValue());
-    return {xPos, yPos};
+    return count;
 }
 
-MinePosition enterBoardPosition(Language& language, Width width, Height height, Player const& player, RandomPosFn randomPos)
+unsigned int countEmptyInRow(Board const& board, unsigned int y)
 {
-    MinePosition minePosition;
-    if (player.type == PlayerType::HumanPlayer)
-    {
-        std::string msgX = language["utilsMsg::kEnterXValue"];
-        auto xPos = utils::enterValueInRange<unsigned int>(language, msgX, static_cast<unsigned int>(0), (width.getValue() - 1));
-        std::string msgY = language["utilsMsg::kEnterYValue"];
-        auto yPos = utils::enterValueInRange<unsigned int>(language, msgY, static_cast<unsigned int>(0), (height.getValue() - 1));
-        minePosition = {xPos, yPos};
-    }
-    else if (player.type == PlayerType::PC)
+    std::size_t rowBegin = board.index(0, y);
+    std::size_t rowEnd = rowBegin + board.width;
+
+    if (board.planes.enabled())
     {
-        minePosition = randomPos(width, height);
+        return countPlaneBits(board.planes.plane(PositionState::Empty), rowBegin, rowEnd);
     }
-    return minePosition;
+
+    return static_cast<unsigned int>(std::count(board.cells.begin() + rowBegin, board.cells.begin() + rowEnd, PositionState::Empty));
 }
 
 std::string showInvalidBoardPositionStateReason(Language& language, PositionState const& state)
@@ -460,13 +283,13 @@ std::string showInvalidBoardPositionStateReason(Language& language, PositionStat
     switch (state)
     {
     case PositionState::GuessedEmpty:
-        message = language["utilsMsg::kAlreadyGuessedMessage"];
+        message = language[MessageId::utilsMsg_kAlreadyGuessedMessage];
         break;
     case PositionState::GuessedMine:
-        message = language["utilsMsg::kAlreadyDetectedMessage"];
+        message = language[MessageId::utilsMsg_kAlreadyDetectedMessage];
         break;
     case PositionState::Removed:
-        message = language["utilsMsg::kRemovedMessage"];
+        message = language[MessageId::utilsMsg_kRemovedMessage];
         break;
     default:
         break;
@@ -474,37 +297,70 @@ std::string showInvalidBoardPositionStateReason(Language& language, PositionStat
     return message;
 }
 
+MinePosition getRandomBoardPosition(Pcg32& random, Width width, Height height)
+{
+    unsigned int xPos = getRandomNumberInRange(random, width.getValue());
+    unsigned int yPos = getRandomNumberInRange(random, height.getValue());
+    return {xPos, yPos};
+}
+
 bool isInvalidBoardPositionState(PositionState const& state)
 {
     return (state == PositionState::GuessedEmpty || state == PositionState::GuessedMine || state == PositionState::Removed);
 }
 
-MinePosition validBoardPositionState(Language& language, Width width, Height height, Player const& player)
+void checkLimits(BoardLimits const& limits)
 {
-    MinePosition minePosition = enterBoardPosition(language, width, height, player, getRandomBoardPosition);
+    if (limits.minWidth < 1 || limits.minHeight < 1 || limits.minWidth > limits.maxWidth || limits.minHeight > limits.maxHeight)
+    {
+        throw std::invalid_argument("Board limits leave no board size to choose");
+    }
 
-    while (isInvalidBoardPositionState(minePosition.state))
+    if (static_cast<long long>(limits.maxWidth) * limits.maxHeight > BoardConfig::Limits::kMaxDenseCells)
     {
-        showInvalidBoardPositionStateReason(language, minePosition.state);
-        minePosition = enterBoardPosition(language, width, height, player, getRandomBoardPosition);
+        throw std::invalid_argument("Board limits allow more cells than a dense board holds (" + std::to_string(BoardConfig::Limits::kMaxDenseCells) + ")");
     }
+}
 
-    minePosition.state = PositionState::WithMine;
+// Board indices are packed in 16 bits (PackedPosition, FreeCellPool), a bigger board would wrap them
+
+void initialize(Board& board, Height height, Width width)
+{
+    if (static_cast<long long>(width.getValue()) * height.getValue() > BoardConfig::Limits::kMaxDenseCells)
+    {
+        throw std::length_error("Board of " + std::to_string(width.getValue()) + "x" + std::to_string(height.getValue()) + " cells is too big for a dense board");
+    }
 
-    return minePosition;
+    board.width = width.getValue();
+    board.height = height.getValue();
+    board.cells.assign(static_cast<std::size_t>(board.width) * board.height, PositionState::Empty);
+    board.stateCounts.fill(0);
+    board.stateCounts[static_cast<std::size_t>(PositionState::Empty)] = static_cast<unsigned int>(board.size());
+    board.owners.assign(board.size(), kNoOwner);
+    board.placementRounds.assign(board.size(), 0);
+    board.freeCells.reset(board.size());
+    board.planes = BoardPlanes{};
+    board.rangeIndex = BoardRangeIndex{};
 }
 
-void initialize(Board& board, Height height, Width width)
+void showPerPlayer(GameContext& context, Player const& player)
 {
-    board.resize(height.getValue());
-    for (unsigned int j = 0; j < height.getValue(); ++j)
+    if (!context.boardView)
     {
-        board[j].resize(width.getValue());
-        for (unsigned int k = 0; k < width.getValue(); ++k)
-        {
-            board[j][k] = MinePosition{j, k, PositionState::Empty};
-        }
+        printPerPlayer(*context.output, context.board, player);
+        return;
     }
+
+    if (!context.output->enabled())
+    {
+        return;
+    }
+
+    context.output->post([view = context.boardView, id = player.id, name = player.name, snapshot = takeSnapshot(context.board),
+                          guessed = player.guessedCells, own = player.ownMineCells](std::string& frame)
+    {
+        view->render(frame, id, name, snapshot, guessed, own, terminal::size());
+    });
 }
 
 } // namespace board
@@ -2,15 +2,51 @@
 #include <minefield/utils.h>
 #include <minefield/types.h>
 
+#include <iomanip>
+#include <sstream>
+
 namespace utils::tests
 {
 TEST(createRandomNumberInRangeFn, should_return) 
 {
-    int num = utils::createRandomNumberInRange(10);
+    Pcg32 random(42);
+    int num = utils::getRandomNumberInRange(random, 10);
     bool cond = num < 10;
     EXPECT_TRUE(cond);
 }
 
+TEST(createRandomNumberInRangeFn, same_seed_and_stream_repeat_the_sequence)
+{
+    Pcg32 a(42, 3);
+    Pcg32 b(42, 3);
+    Pcg32 otherStream(42, 4);
+
+    bool sameAsOtherStream = true;
+    for (int i = 0; i < 100; ++i)
+    {
+        unsigned int value = a();
+        EXPECT_EQ(value, b());
+        sameAsOtherStream = sameAsOtherStream && (value == otherStream());
+    }
+    EXPECT_FALSE(sameAsOtherStream);
+}
+
+TEST(createRandomNumberInRangeFn, bounded_covers_the_range_evenly)
+{
+    Pcg32 random(7);
+    std::array<unsigned int, 6> counts{};
+
+    for (int i = 0; i < 60000; ++i)
+    {
+        ++counts[utils::getRandomNumberInRange(random, 6)];
+    }
+
+    for (unsigned int count : counts)
+    {
+        EXPECT_NEAR(count, 10000, 500);
+    }
+}
+
 TEST(isMineFromPlayer, should_return_true_when_mine_is_from_player)
 {
     MinePosition guess{ 1, 1 };
@@ -34,8 +70,8 @@ TEST(isInvalidPosition, should_return_false_if_mine_is_empty_or_with_mine)
 {
     MinePosition mineA{ 1, 1, PositionState::Empty };
     MinePosition mineB{ 1, 1, PositionState::WithMine };
-    EXPECT_FALSE(utils::board::isInvalidPosition(mineA.state));
-    EXPECT_FALSE(utils::board::isInvalidPosition(mineB.state));
+    EXPECT_FALSE(utils::board::isInvalidBoardPositionState(mineA.state));
+    EXPECT_FALSE(utils::board::isInvalidBoardPositionState(mineB.state));
 }
 TEST(nameExists, should_return_false_if_player_vector_is_empty) 
 {
@@ -54,26 +90,371 @@ TEST(nameExists, should_return_true_if_name_exists_in_player_vector)
 
 TEST(checkBoardFull, should_return_true_if_board_is_full)
 {
-    unsigned int width = 5;
-    unsigned int height = 5;
+    Language language;
     Players players;
     Board board;
-    utils::board::initialize(board, height, width);
+    utils::board::initialize(board, Height{5}, Width{5});
     
-    for (unsigned int y = 0; y < board[0].size(); y++)
+    for (unsigned int y = 0; y < board.height; y++)
+    {
+        for (unsigned int x = 0; x < board.width; x++)
+        {
+            board.setState(x, y, PositionState::WithMine);
+        }
+    }
+
+    NullSink output;
+    EXPECT_TRUE(utils::board::isFull(language, output, board, players));
+}
+
+TEST(checkBoardFull, should_return_false_if_one_position_is_empty)
+{
+    Language language;
+    Players players;
+    Board board;
+    utils::board::initialize(board, Height{5}, Width{5});
+
+    for (unsigned int y = 0; y < board.height; y++)
+    {
+        for (unsigned int x = 0; x < board.width; x++)
+        {
+            board.setState(x, y, PositionState::GuessedEmpty);
+        }
+    }
+    board.setState(4, 2, PositionState::Empty);
+
+    NullSink output;
+    EXPECT_FALSE(utils::board::isFull(language, output, board, players));
+}
+
+TEST(initializeBoard, should_store_cells_row_major_in_one_block)
+{
+    Board board;
+    utils::board::initialize(board, Height{3}, Width{4});
+
+    EXPECT_EQ(board.size(), 12u);
+    EXPECT_EQ(board.index(3, 0), 3u);
+    EXPECT_EQ(board.index(0, 1), 4u);
+
+    board.setState(1, 2, PositionState::WithMine);
+    EXPECT_EQ(board[9], PositionState::WithMine);
+    EXPECT_EQ(board.state(2, 1), PositionState::Empty);
+}
+
+TEST(initializeBoard, should_refuse_boards_too_big_for_packed_indices)
+{
+    Board board;
+
+    EXPECT_NO_THROW(utils::board::initialize(board, Height{256}, Width{256}));
+    EXPECT_THROW(utils::board::initialize(board, Height{257}, Width{256}), std::length_error);
+
+    BoardLimits limits;
+    EXPECT_NO_THROW(utils::board::checkLimits(limits));
+
+    limits.maxWidth = 1000;
+    limits.maxHeight = 1000;
+    EXPECT_THROW(utils::board::checkLimits(limits), std::invalid_argument);
+}
+
+TEST(boardPlanes, should_stay_in_sync_with_cell_states)
+{
+    Board board;
+    utils::board::initialize(board, Height{7}, Width{11});
+    board.setState(3, 2, PositionState::WithMine);
+    utils::board::enablePlanes(board);
+
+    board.setState(0, 0, PositionState::GuessedMine);
+    board.setState(10, 6, PositionState::GuessedMine);
+    board.setState(4, 2, PositionState::GuessedEmpty);
+    board.setState(3, 2, PositionState::Removed);
+
+    for (std::size_t state = 0; state < kPositionStateCount; ++state)
+    {
+        PositionState positionState = static_cast<PositionState>(state);
+        EXPECT_EQ(utils::board::countState(board, positionState), static_cast<unsigned int>(std::count(board.cells.begin(), board.cells.end(), positionState)));
+    }
+
+    EXPECT_EQ(utils::board::countState(board, PositionState::GuessedMine), 2u);
+    EXPECT_EQ(utils::board::countEmptyInRow(board, 2), 9u);
+    EXPECT_EQ(utils::board::countEmptyInRow(board, 6), 10u);
+    EXPECT_TRUE(utils::board::hasEmptyPositions(board));
+}
+
+TEST(boardStateCounts, should_follow_every_state_change)
+{
+    Board board;
+    utils::board::initialize(board, Height{4}, Width{6});
+    EXPECT_EQ(board.count(PositionState::Empty), 24u);
+
+    board.setState(1, 1, PositionState::WithMine);
+    board.setState(2, 1, PositionState::WithMine);
+    board.setState(2, 1, PositionState::Removed);
+    board.setState(1, 1, PositionState::GuessedMine);
+    board.setState(5, 3, PositionState::GuessedEmpty);
+
+    EXPECT_EQ(board.count(PositionState::Empty), 21u);
+    EXPECT_EQ(board.count(PositionState::WithMine), 0u);
+    EXPECT_EQ(board.count(PositionState::Removed), 1u);
+    EXPECT_EQ(board.count(PositionState::GuessedMine), 1u);
+    EXPECT_EQ(board.count(PositionState::GuessedEmpty), 1u);
+}
+
+TEST(freeCellPool, should_hold_exactly_the_cells_that_can_be_picked)
+{
+    Board board;
+    utils::board::initialize(board, Height{4}, Width{6});
+    EXPECT_EQ(board.freeCells.size(), 24u);
+
+    board.setState(1, 1, PositionState::WithMine);
+    board.setState(2, 1, PositionState::Removed);
+    board.setState(5, 3, PositionState::GuessedEmpty);
+    board.setState(0, 0, PositionState::GuessedMine);
+    board.setState(0, 0, PositionState::Empty);
+
+    EXPECT_EQ(board.freeCells.size(), 22u);
+
+    for (std::size_t i = 0; i < board.size(); ++i)
+    {
+        EXPECT_EQ(board.freeCells.contains(i), isFreeState(board[i]));
+    }
+
+    for (std::size_t slot = 0; slot < board.freeCells.size(); ++slot)
+    {
+        EXPECT_EQ(board.freeCells.slots[board.freeCells.cells[slot]], slot);
+    }
+}
+
+TEST(validBoardPositionState, pc_should_only_pick_free_cells)
+{
+    Board board;
+    utils::board::initialize(board, Height{4}, Width{6});
+
+    for (unsigned int y = 0; y < board.height; ++y)
+    {
+        for (unsigned int x = 0; x < board.width; ++x)
+        {
+            board.setState(x, y, (x == 4 && y == 2) ? PositionState::WithMine : PositionState::GuessedEmpty);
+        }
+    }
+
+    Language language;
+    NullSink output;
+    Pcg32 random(3);
+    Player pc = utils::player::createPlayer("PC", MinesCount{3}, PlayerCreation::Options::kPC);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        std::optional<MinePosition> pick = utils::board::validBoardPositionState(language, output, random, board, pc);
+        ASSERT_TRUE(pick.has_value());
+        EXPECT_EQ(pick->x, 4u);
+        EXPECT_EQ(pick->y, 2u);
+        EXPECT_EQ(pick->state, PositionState::WithMine);
+    }
+
+    board.setState(4, 2, PositionState::Removed);
+    EXPECT_FALSE(utils::board::validBoardPositionState(language, output, random, board, pc).has_value());
+}
+
+TEST(validBoardPositionState, human_should_be_asked_again_for_a_used_cell)
+{
+    Board board;
+    utils::board::initialize(board, Height{4}, Width{6});
+    board.setState(1, 1, PositionState::GuessedEmpty);
+
+    Language language{{MessageId::utilsMsg_kAlreadyGuessedMessage, "Position was already guessed.\n"}};
+    BufferSink output;
+    Pcg32 random;
+    Player human = utils::player::createPlayer("H", MinesCount{3}, PlayerCreation::Options::kHuman);
+
+    std::istringstream input("1 1 3 2");
+    std::streambuf* stdinBuffer = std::cin.rdbuf(input.rdbuf());
+    std::optional<MinePosition> pick = utils::board::validBoardPositionState(language, output, random, board, human);
+    std::cin.rdbuf(stdinBuffer);
+
+    ASSERT_TRUE(pick.has_value());
+    EXPECT_EQ(pick->x, 3u);
+    EXPECT_EQ(pick->y, 2u);
+    EXPECT_NE(output.text().find("Position was already guessed."), std::string::npos);
+}
+
+TEST(validBoardPositionState, human_should_not_be_asked_without_free_cells)
+{
+    Board board;
+    utils::board::initialize(board, Height{2}, Width{3});
+
+    for (unsigned int y = 0; y < board.height; ++y)
+    {
+        for (unsigned int x = 0; x < board.width; ++x)
+        {
+            board.setState(x, y, PositionState::GuessedMine);
+        }
+    }
+
+    Language language;
+    BufferSink output;
+    Pcg32 random;
+    Player human = utils::player::createPlayer("H", MinesCount{3}, PlayerCreation::Options::kHuman);
+
+    std::istringstream input("");
+    std::streambuf* stdinBuffer = std::cin.rdbuf(input.rdbuf());
+    std::optional<MinePosition> pick = utils::board::validBoardPositionState(language, output, random, board, human);
+    std::cin.rdbuf(stdinBuffer);
+
+    EXPECT_FALSE(pick.has_value());
+    EXPECT_EQ(output.text(), "");
+}
+
+TEST(printPerPlayer, should_show_own_mines_and_guessed_positions_only)
+{
+    Board board;
+    utils::board::initialize(board, Height{2}, Width{3});
+
+    Player player;
+    player.placedMines.push_back(board.pack({0, 1, PositionState::WithMine}));
+    player.placedGuesses.push_back(board.pack({2, 0, PositionState::WithMine}));
+    board.setState(0, 1, PositionState::WithMine);
+    board.setState(1, 1, PositionState::WithMine);
+    board.setState(2, 0, PositionState::GuessedEmpty);
+    utils::player::saveMines(player, board);
+    utils::player::saveGuesses(player, board);
+
+    BufferSink output;
+    utils::board::printPerPlayer(output, board, player);
+
+    EXPECT_EQ(output.text(), "     0  1  2\n  0  0  0  3\n  1  1  0  0\n");
+}
+
+TEST(frameGlyphs, should_pad_every_number_like_setw)
+{
+    for (unsigned int number = 0; number < 1200; ++number)
+    {
+        std::ostringstream expected;
+        expected << std::setw(Display::kBoardColWidth) << number;
+
+        std::string glyph;
+        utils::board::kFrameGlyphs.append(glyph, number);
+
+        ASSERT_EQ(glyph, expected.str());
+    }
+}
+
+TEST(handleOpponentMine, should_name_the_owner_recorded_in_the_cell)
+{
+    Language language{{MessageId::ProcessingGuesses_kHitOpponentMine, ""}, {MessageId::ProcessingGuesses_kItWasPlayersMine, "owner={}"}};
+    Board board;
+    utils::board::initialize(board, Height{5}, Width{5});
+
+    Players players(3);
+    for (unsigned int i = 0; i < players.size(); ++i)
     {
-        for (unsigned int x = 0; x < board.size(); x++)
+        players[i].id = i;
+        players[i].name = "p" + std::to_string(i);
+    }
+
+    board.placeMine(3, 4, players[2].id, 2);
+    EXPECT_EQ(board.owner(3, 4), 2u);
+    EXPECT_EQ(board.placementRound(3, 4), 2u);
+
+    BufferSink output;
+    utils::game::handleOpponentMine(language, output, players[0], {3, 4}, board, players);
+
+    EXPECT_EQ(output.text(), "owner=p2");
+    EXPECT_EQ(board.state(3, 4), PositionState::GuessedMine);
+    EXPECT_EQ(players[0].opponentMinesDetected.getValue(), 1u);
+}
+
+TEST(findCollisions, should_report_each_shared_position_once_in_player_order)
+{
+    Board board;
+    utils::board::initialize(board, Height{5}, Width{5});
+
+    Players players(3);
+    players[0].placedMines = {board.pack({1, 1}), board.pack({2, 2}), board.pack({4, 0})};
+    players[1].placedMines = {board.pack({4, 0}), board.pack({3, 3})};
+    players[2].placedMines = {board.pack({3, 3}), board.pack({1, 1}), board.pack({4, 0})};
+
+    std::vector<unsigned int> placementCounts;
+    std::vector<MinePosition> collisions = utils::game::findCollisions(board, players, placementCounts);
+
+    ASSERT_EQ(collisions.size(), 3u);
+    EXPECT_EQ(collisions[0], (MinePosition{1, 1}));
+    EXPECT_EQ(collisions[1], (MinePosition{4, 0}));
+    EXPECT_EQ(collisions[2], (MinePosition{3, 3}));
+    EXPECT_EQ(std::count(placementCounts.begin(), placementCounts.end(), 0u), 25);
+}
+
+TEST(packedPosition, should_round_trip_through_the_board_index)
+{
+    Board board;
+    utils::board::initialize(board, Height{24}, Width{50});
+
+    MinePosition position{49, 23, PositionState::GuessedMine};
+    PackedPosition packed = board.pack(position);
+    MinePosition unpacked = board.unpack(packed);
+
+    EXPECT_EQ(sizeof(PackedPosition), 4u);
+    EXPECT_EQ(packed.index, 23u * 50u + 49u);
+    EXPECT_EQ(unpacked, position);
+    EXPECT_EQ(unpacked.state, PositionState::GuessedMine);
+}
+
+TEST(boardRangeIndex, should_count_states_in_any_rectangle_like_a_scan)
+{
+    Board indexed;
+    Board scanned;
+    utils::board::initialize(indexed, Height{9}, Width{13});
+    utils::board::initialize(scanned, Height{9}, Width{13});
+
+    indexed.setState(12, 8, PositionState::WithMine);
+    utils::board::enableRangeIndex(indexed);
+    scanned.setState(12, 8, PositionState::WithMine);
+
+    for (unsigned int i = 0; i < 60; ++i)
+    {
+        unsigned int x = (i * 7) % 13;
+        unsigned int y = (i * 5) % 9;
+        PositionState state = static_cast<PositionState>(i % kPositionStateCount);
+        indexed.setState(x, y, state);
+        scanned.setState(x, y, state);
+    }
+
+    for (std::size_t state = 0; state < kPositionStateCount; ++state)
+    {
+        PositionState positionState = static_cast<PositionState>(state);
+
+        for (unsigned int x0 = 0; x0 < 13; x0 += 3)
         {
-            board[y][x].state = PositionState::WithMine;
+            for (unsigned int y0 = 0; y0 < 9; y0 += 2)
+            {
+                MinePosition from{x0, y0};
+                MinePosition to{x0 + (12 - x0) / 2, y0 + (8 - y0) / 3};
+                EXPECT_EQ(utils::board::countStateInArea(indexed, positionState, from, to), utils::board::countStateInArea(scanned, positionState, from, to));
+            }
         }
+
+        EXPECT_EQ(utils::board::countStateInArea(indexed, positionState, {0, 0}, {12, 8}), indexed.count(positionState));
     }
+}
+
+TEST(printMessage, should_not_look_up_nor_format_for_a_null_sink)
+{
+    Language language{{MessageId::Results_kWinnerWins, "{} WINS!\n"}};
+    std::string name = "p1";
+
+    BufferSink buffer;
+    utils::printMessage(buffer, language, MessageId::Results_kWinnerWins, name);
+    EXPECT_EQ(buffer.text(), "p1 WINS!\n");
 
-    EXPECT_TRUE(utils::board::isFull(width, height, board, players));
+    NullSink null;
+    utils::printMessage(null, language, MessageId::Results_kScoreOfPlayer, name, 3);
+    EXPECT_FALSE(language.has(MessageId::Results_kScoreOfPlayer));
 }
 
 TEST(getPlayerWithHighestScore, should_return_nullptr_if_player_is_empty)
 {
-    EXPECT_EQ(utils::player::getTopScorer(Players{}), nullptr);
+    Language language;
+    NullSink output;
+    EXPECT_EQ(utils::player::getTopScorer(language, output, Players{}), nullptr);
 }
 
 }